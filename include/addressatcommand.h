@@ -68,8 +68,20 @@ class AddressAtCommand : public NonKeyedCommand
         */
         virtual Command* clone();
 
+        /*!
+        *   \brief Check whether an address names a Unix domain socket
+        *   \param address The address of the database node
+        *   \returns True if address is of the form unix://path
+        */
+        inline bool is_unix_socket(const std::string& address)
+        {
+            return address.rfind("unix://", 0) == 0;
+        }
+
         /*!
         *   \brief Returns host of database node
+        *   \details For a Unix domain socket address of the form
+        *            unix://path, the host is the socket path.
         *   \param address The address of the database node
         *   \returns The host of the database node
         *   \throw RuntimeException if ':' is at the start of address,
@@ -79,6 +91,14 @@ class AddressAtCommand : public NonKeyedCommand
         inline std::string parse_host(std::string address)
         {
             std::string host;
+            if (is_unix_socket(address)) {
+                if (address.size() == 7) {
+                    throw SRRuntimeException(std::string(address) +
+                                             " is not a valid database node address.");
+                }
+                return address.substr(7);
+            }
+
             size_t end_position = address.find(":");
 
             if (end_position == 0 || end_position == std::string::npos) {
@@ -98,7 +118,8 @@ class AddressAtCommand : public NonKeyedCommand
         /*!
         *   \brief Returns port of database node
         *   \param address The address of the database node
-        *   \returns The port of the database node
+        *   \returns The port of the database node, which is 0
+        *            for a Unix domain socket address
         *   \throw RuntimeException if ':' is at the end of the address,
         *          or if ':' is not found in address, or if the port
         *          conversion to uint64_t cannot be performed, or if the
@@ -108,6 +129,9 @@ class AddressAtCommand : public NonKeyedCommand
         */
         inline uint64_t parse_port(std::string address)
         {
+            if (is_unix_socket(address))
+                return 0;
+
             size_t start_position = address.find(":");
             if ((start_position >= address.size() - 1) || (start_position == std::string::npos)) {
                 throw SRRuntimeException(std::string(address) +
@@ -0,0 +1,123 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_ASYNCQUEUE_H
+#define SMARTREDIS_ASYNCQUEUE_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+///@file
+
+namespace SmartRedis {
+
+class AsyncQueue;
+
+/*!
+*   \brief The AsyncQueue class executes submitted tasks, in
+*          submission order, on a dedicated I/O thread.
+*   \details The I/O thread is started on construction.  Tasks
+*            report their own results (e.g. through a promise),
+*            so the AsyncQueue does not inspect them.
+*/
+class AsyncQueue
+{
+    public:
+
+        /*!
+        *   \brief AsyncQueue constructor.  Starts the I/O thread.
+        */
+        AsyncQueue();
+
+        /*!
+        *   \brief AsyncQueue copy constructor is not allowed
+        *   \param queue The AsyncQueue to copy for construction
+        */
+        AsyncQueue(const AsyncQueue& queue) = delete;
+
+        /*!
+        *   \brief AsyncQueue copy assignment is not allowed
+        *   \param queue The AsyncQueue to copy for assignment
+        */
+        AsyncQueue& operator=(const AsyncQueue& queue) = delete;
+
+        /*!
+        *   \brief AsyncQueue destructor.  Every task that has
+        *          already been submitted is completed before the
+        *          I/O thread is joined.
+        */
+        ~AsyncQueue();
+
+        /*!
+        *   \brief Submit a task for execution on the I/O thread
+        *   \param task The task to execute.  The task must not
+        *               throw; failures should be reported through
+        *               the mechanism the task was built with.
+        */
+        void submit(std::function<void()> task);
+
+    private:
+
+        /*!
+        *   \brief Execute tasks until the AsyncQueue is stopped
+        *          and no tasks remain
+        */
+        void _process();
+
+        /*!
+        *   \brief The tasks waiting for execution
+        */
+        std::deque<std::function<void()>> _tasks;
+
+        /*!
+        *   \brief Mutex guarding the task queue and stop flag
+        */
+        std::mutex _mutex;
+
+        /*!
+        *   \brief Condition used to wake the I/O thread
+        */
+        std::condition_variable _cv;
+
+        /*!
+        *   \brief Flag indicating that the AsyncQueue is being destroyed
+        */
+        bool _stopping;
+
+        /*!
+        *   \brief The I/O thread
+        */
+        std::thread _thread;
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_ASYNCQUEUE_H
@@ -172,6 +172,36 @@ SRError put_tensor(void* c_client,
                    SRTensorType type,
                    SRMemoryLayout mem_layout);
 
+/*!
+*   \brief Put multiple tensors into the database
+*   \details All of the tensors are sent to the database with
+*            pipelined commands, one pipeline per database node.
+*            The keys under which the tensors are stored
+*            may be formed by applying a prefix to the supplied
+*            names. See use_tensor_ensemble_prefix()
+*            for more details.
+*   \param c_client The client object to use for communication
+*   \param names The names by which the tensors should be accessed
+*   \param name_lengths The length of each tensor name string,
+*                       excluding null terminating character
+*   \param data The data to store with each tensor
+*   \param dims The number of elements for each dimension of each tensor
+*   \param n_dims The number of dimensions of each tensor
+*   \param types The data type of each tensor
+*   \param mem_layouts The memory layout of the data of each tensor
+*   \param n_tensors The number of tensors
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_tensors(void* c_client,
+                    const char** names,
+                    const size_t* name_lengths,
+                    void** data,
+                    const size_t** dims,
+                    const size_t* n_dims,
+                    const SRTensorType* types,
+                    const SRMemoryLayout* mem_layouts,
+                    const size_t n_tensors);
+
 /*!
 *   \brief Get the data, dimensions, and type for a tensor in the
 *          database. This function will allocate and retain management of the
@@ -242,6 +272,39 @@ SRError unpack_tensor(void* c_client,
                      SRTensorType type,
                      SRMemoryLayout mem_layout);
 
+/*!
+*   \brief Retrieve multiple tensors from the database into memory
+*          provided by the caller
+*   \details All of the tensors are fetched with pipelined commands,
+*            one pipeline per database node.
+*            The final tensor keys used to retrieve the tensors
+*            may be formed by applying a prefix to the supplied
+*            names. See set_data_source()
+*            and use_tensor_ensemble_prefix() for more details.
+*   \param c_client The client object to use for communication
+*   \param names The names by which the tensors should be accessed
+*   \param name_lengths The length of each supplied name string,
+*                       excluding null terminating character
+*   \param results The data buffers into which the tensor data should
+*                  be written
+*   \param dims The number of elements in each dimension of each
+*               provided memory space
+*   \param n_dims The number of dimensions in each provided memory space
+*   \param types The data type for each provided memory space.
+*   \param mem_layouts The memory layout for each provided memory space.
+*   \param n_tensors The number of tensors
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError unpack_tensors(void* c_client,
+                       const char** names,
+                       const size_t* name_lengths,
+                       void** results,
+                       const size_t** dims,
+                       const size_t* n_dims,
+                       const SRTensorType* types,
+                       const SRMemoryLayout* mem_layouts,
+                       const size_t n_tensors);
+
 /*!
 *   \brief Move a tensor to a new name
 *   \details The old and new tensor keys used to find and
@@ -837,6 +900,144 @@ SRError use_tensor_ensemble_prefix(void* c_client, bool use_prefix);
 */
 SRError use_model_ensemble_prefix(void* c_client, bool use_prefix);
 
+/*!
+*   \brief Put a tensor into the database asynchronously
+*   \details The request is executed on the client's I/O thread in the
+*            order in which asynchronous requests were made. The tensor
+*            data are copied before this function returns, so the data
+*            buffer may be reused immediately. The request handle must
+*            be released with wait_request().
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor should be accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param data The data to store with the tensor
+*   \param dims The number of elements for each dimension of the tensor
+*   \param n_dims The number of dimensions of the tensor
+*   \param type The data type of the tensor
+*   \param mem_layout The memory layout of the data
+*   \param request Receives the handle of the request
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_tensor_async(void* c_client,
+                         const char* name,
+                         const size_t name_length,
+                         void* data,
+                         const size_t* dims,
+                         const size_t n_dims,
+                         const SRTensorType type,
+                         const SRMemoryLayout mem_layout,
+                         void** request);
+
+/*!
+*   \brief Retrieve a tensor into a pre-allocated memory
+*          space asynchronously
+*   \details The request is executed on the client's I/O thread in the
+*            order in which asynchronous requests were made. The result
+*            buffer is written from that thread and must remain valid
+*            until wait_request() returns for this request.
+*   \param c_client The client object to use for communication
+*   \param name The name by which the tensor is accessed
+*   \param name_length The length of the tensor name string,
+*                      excluding null terminating character
+*   \param result The memory space to fill with tensor data
+*   \param dims The dimensions of the memory space
+*   \param n_dims The number of dimensions of the memory space
+*   \param type The data type of the memory space
+*   \param mem_layout The memory layout of the memory space
+*   \param request Receives the handle of the request
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError unpack_tensor_async(void* c_client,
+                            const char* name,
+                            const size_t name_length,
+                            void* result,
+                            const size_t* dims,
+                            const size_t n_dims,
+                            const SRTensorType type,
+                            const SRMemoryLayout mem_layout,
+                            void** request);
+
+/*!
+*   \brief Run a model in the database asynchronously
+*   \details The request is executed on the client's I/O thread in the
+*            order in which asynchronous requests were made, so it
+*            observes earlier put_tensor_async() requests.
+*   \param c_client The client object to use for communication
+*   \param name The name associated with the model
+*   \param name_length The length of the name string,
+*                      excluding null terminating character
+*   \param inputs The names of the input tensors
+*   \param input_lengths The lengths of the input name strings,
+*                        excluding null terminating character
+*   \param n_inputs The number of input tensors
+*   \param outputs The names of the output tensors
+*   \param output_lengths The lengths of the output name strings,
+*                         excluding null terminating character
+*   \param n_outputs The number of output tensors
+*   \param request Receives the handle of the request
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError run_model_async(void* c_client,
+                        const char* name,
+                        const size_t name_length,
+                        const char** inputs,
+                        const size_t* input_lengths,
+                        const size_t n_inputs,
+                        const char** outputs,
+                        const size_t* output_lengths,
+                        const size_t n_outputs,
+                        void** request);
+
+/*!
+*   \brief Put a dataset into the database asynchronously
+*   \details The dataset is copied before this function returns,
+*            so it may be modified or deallocated immediately.
+*   \param c_client The client object to use for communication
+*   \param dataset The dataset to store
+*   \param request Receives the handle of the request
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError put_dataset_async(void* c_client, void* dataset, void** request);
+
+/*!
+*   \brief Retrieve a dataset from the database asynchronously
+*   \details The dataset pointer is written when wait_request()
+*            completes this request, so the dataset argument must
+*            remain valid until then. The caller is responsible for
+*            deallocating the retrieved dataset.
+*   \param c_client The client object to use for communication
+*   \param name The name of the dataset to retrieve
+*   \param name_length The length of the name string,
+*                      excluding null terminating character
+*   \param dataset Receives the retrieved dataset
+*   \param request Receives the handle of the request
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError get_dataset_async(void* c_client, const char* name,
+                          const size_t name_length, void** dataset,
+                          void** request);
+
+/*!
+*   \brief Wait for an asynchronous request to complete
+*   \details The request handle is released and set to NULL whether
+*            or not the request succeeded.
+*   \param request The handle of the request
+*   \return Returns SRNoError if the request succeeded or the error
+*           code of the failed request
+*/
+SRError wait_request(void** request);
+
+/*!
+*   \brief Check whether an asynchronous request has completed
+*   \details A completed request must still be released
+*            with wait_request().
+*   \param request The handle of the request
+*   \param completed Receives true if the request has completed
+*   \return Returns SRNoError on success or an error code on failure
+*/
+SRError test_request(void* request, bool* completed);
+
 #ifdef __cplusplus
 }
 
@@ -37,9 +37,16 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <future>
+#include <memory>
 #include "redisserver.h"
 #include "rediscluster.h"
 #include "redis.h"
+#include "asyncqueue.h"
+#include "readcache.h"
+#include "sharedtensorcache.h"
+#include "preparedput.h"
+#include "preparedunpack.h"
 #include "dataset.h"
 #include "sharedmemorylist.h"
 #include "command.h"
@@ -134,6 +141,11 @@ class Client
         *            the dataset may be formed by applying prefixes to the
         *            supplied old_name and new_name. See set_data_source()
         *            and use_tensor_ensemble_prefix() for more details.
+        *            When the old and new keys are co-located, the keys
+        *            are renamed in place by one server-side script, so
+        *            that a missing key leaves the dataset untouched;
+        *            otherwise
+        *            the dataset is copied and the original deleted.
         *   \param old_name The original dataset key for the dataset
         *   \param new_name The new dataset key for the dataset
         *   \throw SmartRedis::Exception if dataset rename command fails
@@ -190,6 +202,63 @@ class Client
                         const SRTensorType type,
                         const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Prepare the repeated put of a tensor with a
+        *          fixed name, type and dimensions
+        *   \details The put command and the routing of the tensor
+        *            key are built once.  Each put_tensor() with the
+        *            returned PreparedPut only supplies the data.  The
+        *            tensor key is formed from the supplied name when
+        *            this method is called.  See
+        *            use_tensor_ensemble_prefix() for more details.
+        *   \param name The tensor name for this tensor in the database
+        *   \param dims The number of elements for each dimension
+        *          of the tensor
+        *   \param type The data type for the tensor
+        *   \returns The PreparedPut to pass to put_tensor()
+        *   \throw SmartRedis::Exception if the name, dimensions
+        *          or type are invalid
+        */
+        PreparedPut prepare_put(const std::string& name,
+                                const std::vector<size_t>& dims,
+                                const SRTensorType type);
+
+        /*!
+        *   \brief Put a tensor into the database with a
+        *          PreparedPut
+        *   \param put The PreparedPut returned by prepare_put()
+        *   \param data The data for this tensor, in a contiguous
+        *               row major memory layout
+        *   \throw SmartRedis::Exception if put tensor command fails
+        */
+        void put_tensor(PreparedPut& put, const void* data);
+
+        /*!
+        *   \brief Put multiple tensors into the database
+        *   \details All of the tensors are sent to the database with
+        *            pipelined commands, one pipeline per database
+        *            node, instead of one round trip per tensor.
+        *            The final tensor keys may be formed by applying
+        *            a prefix to the supplied names.
+        *            See use_tensor_ensemble_prefix() for more details.
+        *            The n-th entry of each argument describes the
+        *            n-th tensor, and names must not be repeated.
+        *   \param names The tensor names for the tensors in the database
+        *   \param data The data for each tensor
+        *   \param dims The number of elements for each dimension
+        *          of each tensor
+        *   \param types The data type for each tensor
+        *   \param mem_layouts The memory layout of each provided
+        *          tensor data
+        *   \throw SmartRedis::Exception if the arguments differ in length
+        *          or if any put tensor command fails
+        */
+        void put_tensors(const std::vector<std::string>& names,
+                         const std::vector<void*>& data,
+                         const std::vector<std::vector<size_t>>& dims,
+                         const std::vector<SRTensorType>& types,
+                         const std::vector<SRMemoryLayout>& mem_layouts);
+
         /*!
         *   \brief Retrieve the tensor data, dimensions, and type for the
         *          provided tensor key. This function will allocate and retain
@@ -265,6 +334,80 @@ class Client
                         SRTensorType& type,
                         const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Retrieve a read-only view of the contiguous data,
+        *          dimensions, and type of a tensor.
+        *   \details The key used to locate the tensor
+        *            may be formed by applying a prefix to the supplied
+        *            name. See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *
+        *            When the shared tensor cache is used, the data
+        *            are mapped from shared memory that is shared with
+        *            the other processes of the compute node, and no
+        *            copy of the tensor is made.  Otherwise, the client
+        *            holds a copy of the tensor as in get_tensor().
+        *            Either way, the data are valid until the Client
+        *            is destroyed and must not be written to.
+        *            See use_shared_tensor_cache() for more details.
+        *   \param name The name used to reference the tensor
+        *   \param data Receives a pointer to the contiguous tensor data
+        *   \param dims Receives the dimensions of the tensor
+        *   \param type Receives the type of the tensor
+        *   \throw SmartRedis::Exception if get tensor command fails
+        */
+        void get_shared_tensor(const std::string& name,
+                               const void*& data,
+                               std::vector<size_t>& dims,
+                               SRTensorType& type);
+
+        /*!
+        *   \brief Retrieve the tensor data, dimensions, and type for
+        *          multiple tensors.  This function will allocate and
+        *          retain management of the memory for the tensor data.
+        *   \details All of the tensors are fetched with pipelined
+        *            commands, one pipeline per database node.
+        *            The tensor keys used to locate the tensors
+        *            may be formed by applying a prefix to the supplied
+        *            names. See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *            The memory returned in data is valid until the
+        *            Client object is destroyed.
+        *   \param names The names of the tensors to retrieve
+        *   \param data Receives the data of each tensor
+        *   \param dims Receives the number of elements in each dimension
+        *               of each tensor
+        *   \param types Receives the type of each tensor
+        *   \param mem_layout The memory layout into which tensor
+        *                     data should be written
+        *   \throw SmartRedis::Exception naming the tensor key if the
+        *          retrieval of any tensor fails
+        */
+        void get_tensors(const std::vector<std::string>& names,
+                         std::vector<void*>& data,
+                         std::vector<std::vector<size_t>>& dims,
+                         std::vector<SRTensorType>& types,
+                         const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Retrieve multiple tensors with pipelined commands
+        *          and return a TensorBase object for each of them
+        *   \details The tensor keys used to locate the tensors
+        *            may be formed by applying a prefix to the supplied
+        *            names. See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *            The caller owns the returned TensorBase objects,
+        *            which always have a MemoryLayout::contiguous
+        *            layout, so that language bindings can hand the
+        *            tensor memory to their own array types.
+        *   \param names The names of the tensors to retrieve
+        *   \returns A TensorBase object for each name, in order
+        *   \throw SmartRedis::Exception naming the tensor key if the
+        *          retrieval of any tensor fails
+        */
+        std::vector<std::unique_ptr<TensorBase>>
+        get_tensor_objects(const std::vector<std::string>& names);
+
         /*!
         *   \brief Retrieve a tensor from the database into memory provided
         *          by the caller
@@ -285,6 +428,66 @@ class Client
                            const SRTensorType type,
                            const SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Prepare the repeated retrieval of a tensor into
+        *          memory spaces with fixed dimensions, type and
+        *          memory layout
+        *   \details The tensor key, its routing and the checks of
+        *            the memory space description are done once.
+        *            The tensor key is formed from the supplied name
+        *            when this method is called.  See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *   \param name  The tensor name for the tensor
+        *   \param dims The dimensions of the memory spaces
+        *   \param type The tensor type of the memory spaces
+        *   \param mem_layout The memory layout of the memory spaces
+        *   \returns The PreparedUnpack to pass to unpack_tensor()
+        *   \throw SmartRedis::Exception if the name or the memory
+        *          space description is invalid
+        */
+        PreparedUnpack prepare_unpack(const std::string& name,
+                                      const std::vector<size_t>& dims,
+                                      const SRTensorType type,
+                                      const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Retrieve a tensor from the database into memory
+        *          provided by the caller with a PreparedUnpack
+        *   \param unpack The PreparedUnpack returned by
+        *                 prepare_unpack()
+        *   \param data A buffer into which to place tensor data
+        *   \throw SmartRedis::Exception if unpack tensor command fails
+        */
+        void unpack_tensor(const PreparedUnpack& unpack, void* data);
+
+        /*!
+        *   \brief Retrieve multiple tensors from the database into
+        *          memory provided by the caller
+        *   \details All of the tensors are fetched with pipelined
+        *            commands, one pipeline per database node.  Each
+        *            buffer is validated in the same way as by
+        *            unpack_tensor().  The tensor keys used to locate
+        *            the tensors may be formed by applying a prefix to
+        *            the supplied names. See set_data_source()
+        *            and use_tensor_ensemble_prefix() for more details.
+        *            The n-th entry of each argument describes the
+        *            n-th tensor.
+        *   \param names The names of the tensors to retrieve
+        *   \param data A buffer into which to place each tensor's data
+        *   \param dims The dimensions of each provided data buffer
+        *   \param types The tensor type of each provided data buffer
+        *   \param mem_layouts The memory layout of each provided
+        *                      data buffer
+        *   \throw SmartRedis::Exception naming the tensor key if the
+        *          arguments differ in length or if unpacking any
+        *          tensor fails
+        */
+        void unpack_tensors(const std::vector<std::string>& names,
+                            const std::vector<void*>& data,
+                            const std::vector<std::vector<size_t>>& dims,
+                            const std::vector<SRTensorType>& types,
+                            const std::vector<SRMemoryLayout>& mem_layouts);
+
         /*!
         *   \brief Move a tensor to a new name
         *   \details The old and new tensor keys used to find and relocate
@@ -598,8 +801,13 @@ class Client
         *            may be formed by applying a prefix to the supplied
         *            name. See set_data_source()
         *            and use_tensor_ensemble_prefix() for more details.
+        *            Between checks, the client blocks on the server
+        *            instead of sleeping, so it returns as soon as the
+        *            dataset is stored rather than at the next interval.
+        *            The blocking wait uses a fractional timeout, which
+        *            requires Redis 6.0 or later.
         *   \param name The dataset name to be checked in the database
-        *   \param poll_frequency_ms The time delay between checks,
+        *   \param poll_frequency_ms The maximum time between checks,
         *                            in milliseconds
         *   \param num_tries The total number of times to check for the name
         *   \returns Returns true if the dataset is found within the
@@ -693,6 +901,63 @@ class Client
         */
         void use_model_ensemble_prefix(bool use_prefix);
 
+        /*!
+        *   \brief Control whether tensors, models and scripts that
+        *          are read are kept in a client side cache.
+        *   \details The cache holds the replies of get_tensor(),
+        *            unpack_tensor(), get_model() and get_script(),
+        *            so that repeated reads of unchanged keys are
+        *            served without contacting the database.  Least
+        *            recently used replies are evicted to keep the
+        *            cache within max_bytes.  The database announces
+        *            changes to the keys that were read through
+        *            client side tracking (CLIENT TRACKING), which
+        *            requires Redis 6 or newer.  Writes made through
+        *            this client are reflected immediately, while
+        *            writes made by other clients are reflected once
+        *            their announcement is received, so a read that
+        *            races with a write by another client may still
+        *            return the previous value.  Reads that cannot be
+        *            tracked are sent to the database as usual.  The
+        *            cache is disabled by default.  This function
+        *            should not be called while asynchronous requests
+        *            are outstanding.
+        *   \param max_bytes The memory budget of the cache in bytes.
+        *                    A value of 0 disables the cache.
+        *   \throw SmartRedis::Exception if the cache cannot be allocated
+        */
+        void use_read_cache(size_t max_bytes);
+
+        /*!
+        *   \brief Control whether tensors that are read are shared
+        *          with the other processes of the compute node.
+        *   \details When the shared tensor cache is used, the first
+        *            process of a compute node to read a tensor with
+        *            get_tensor(), unpack_tensor() or
+        *            get_shared_tensor() places it in POSIX shared
+        *            memory, and the other processes of the node read
+        *            it from there instead of from the database.
+        *            get_shared_tensor() maps the shared memory
+        *            without making a copy.  Tensors written through a
+        *            client that uses the cache are removed from it,
+        *            but writes made through other clients are not
+        *            seen, so the cache should be used for tensors
+        *            that do not change once they are read, such as
+        *            broadcast fields and model weights.  Shared
+        *            memory is released when the last process using a
+        *            tensor destroys its client.  Segments left behind
+        *            by a process that stopped without destroying its
+        *            client are never read by a later database
+        *            instance, and can be removed with
+        *            rm /dev/shm/sr.<uid>.* once no process of the
+        *            user on the compute node uses the cache.  The
+        *            cache is not used by default.
+        *   \param use_cache If set to true, tensors that are read are
+        *                    shared through the cache
+        *   \throw SmartRedis::Exception if the cache cannot be allocated
+        */
+        void use_shared_tensor_cache(bool use_cache);
+
         /*!
         *   \brief Returns information about the given database node
         *   \param address The address of the database node (host:port)
@@ -826,6 +1091,83 @@ class Client
         */
         void save(std::string address);
 
+        /*!
+        *   \brief Asynchronously put a tensor into the database
+        *   \details The request is executed on an internal I/O thread
+        *            in the order in which asynchronous requests were
+        *            made. The tensor data are copied before this method
+        *            returns, so the data buffer may be reused immediately.
+        *            Errors are reported when the returned future is
+        *            waited upon.
+        *   \param name The name used to reference the tensor
+        *   \param data The data to send to the database
+        *   \param dims The dimensions of the data
+        *   \param type The data type of the tensor
+        *   \param mem_layout The memory layout of the provided data
+        *   \returns A future that becomes ready when the tensor is stored
+        *   \throw SmartRedis::Exception if the tensor cannot be built
+        */
+        std::future<void> put_tensor_async(const std::string& name,
+                                           void* data,
+                                           const std::vector<size_t>& dims,
+                                           const SRTensorType type,
+                                           const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Asynchronously retrieve a tensor into an already
+        *          allocated memory space
+        *   \details The request is executed on an internal I/O thread
+        *            in the order in which asynchronous requests were
+        *            made. The data buffer is written from that thread
+        *            and must remain valid and untouched until the
+        *            returned future is ready.
+        *   \param name The name used to reference the tensor
+        *   \param data A buffer into which to place tensor data
+        *   \param dims The dimensions for the provided data buffer
+        *   \param type The tensor type for the provided data buffer
+        *   \param mem_layout The memory layout for the provided data buffer
+        *   \returns A future that becomes ready when the buffer is filled
+        *   \throw SmartRedis::Exception if the provided dimensions are
+        *          invalid for the memory layout
+        */
+        std::future<void> unpack_tensor_async(const std::string& name,
+                                              void* data,
+                                              const std::vector<size_t>& dims,
+                                              const SRTensorType type,
+                                              const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Asynchronously run a model in the database
+        *   \details The request is executed on an internal I/O thread
+        *            in the order in which asynchronous requests were
+        *            made, so it observes earlier put_tensor_async()
+        *            requests.
+        *   \param name The name associated with the model
+        *   \param inputs The names of input tensors for the model
+        *   \param outputs The names of output tensors for the model
+        *   \returns A future that becomes ready when the model has run
+        */
+        std::future<void> run_model_async(const std::string& name,
+                                          std::vector<std::string> inputs,
+                                          std::vector<std::string> outputs);
+
+        /*!
+        *   \brief Asynchronously put a DataSet object into the database
+        *   \details The DataSet is copied before this method returns,
+        *            so it may be modified or destroyed immediately.
+        *   \param dataset The DataSet object to send to the database
+        *   \returns A future that becomes ready when the DataSet is stored
+        *   \throw SmartRedis::Exception if the DataSet cannot be copied
+        */
+        std::future<void> put_dataset_async(DataSet& dataset);
+
+        /*!
+        *   \brief Asynchronously retrieve a DataSet object from the database
+        *   \param name The name of the dataset to retrieve
+        *   \returns A future holding the retrieved DataSet
+        */
+        std::future<DataSet> get_dataset_async(const std::string& name);
+
     protected:
 
         /*!
@@ -961,12 +1303,135 @@ class Client
         */
         TensorBase* _get_tensorbase_obj(const std::string& name);
 
+        /*!
+        *   \brief Fetch a tensor from the read cache or the database
+        *          and return a TensorBase object for it.  The returned
+        *          TensorBase object has been dynamically allocated,
+        *          but not yet tracked for memory management in
+        *          any object.
+        *   \param get_key The database key of the tensor
+        *   \returns A TensorBase object.
+        */
+        TensorBase* _fetch_tensorbase_obj(const std::string& get_key);
+
+        /*!
+        *   \brief Build a TensorBase object from the CommandReply
+        *          of an AI.TENSORGET command.  The returned
+        *          TensorBase object has been dynamically allocated,
+        *          but not yet tracked for memory management in
+        *          any object.
+        *   \param get_key The database key of the tensor
+        *   \param reply The CommandReply of the AI.TENSORGET command
+        *   \returns A TensorBase object.
+        */
+        TensorBase* _get_tensorbase_obj(const std::string& get_key,
+                                        CommandReply& reply);
+
+        /*!
+        *   \brief Build a TensorBase object from fetched contiguous
+        *          tensor data.  The returned TensorBase object has
+        *          been dynamically allocated, but not yet tracked
+        *          for memory management in any object.
+        *   \param get_key The database key of the tensor
+        *   \param dims The dimensions of the tensor
+        *   \param type The type of the tensor
+        *   \param data The contiguous tensor data, which are copied
+        *   \returns A TensorBase object.
+        */
+        TensorBase* _get_tensorbase_obj(const std::string& get_key,
+                                        const std::vector<size_t>& dims,
+                                        const SRTensorType type,
+                                        const void* data);
+
+        /*!
+        *   \brief Run pipelined AI.TENSORGET commands for the
+        *          provided tensor keys
+        *   \param get_keys The database keys of the tensors
+        *   \returns The CommandReply for each key, in order
+        */
+        std::vector<CommandReply>
+        _get_tensor_replies(const std::vector<std::string>& get_keys);
+
+        /*!
+        *   \brief Check that a destination memory space is described
+        *          correctly for unpacking a tensor
+        *   \param dims The dimensions of the memory space
+        *   \param mem_layout The memory layout of the memory space
+        *   \throw RuntimeException if the dimensions are not valid
+        *          for the memory layout
+        */
+        inline void _check_unpack_dims(const std::vector<size_t>& dims,
+                                       const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Unpack the tensor held in the CommandReply of an
+        *          AI.TENSORGET command into memory provided by the
+        *          caller, after checking the provided type and
+        *          dimensions against the fetched tensor
+        *   \param get_key The database key of the tensor
+        *   \param reply The CommandReply of the AI.TENSORGET command
+        *   \param data A buffer into which to place tensor data
+        *   \param dims The dimensions for the provided data buffer
+        *   \param type The tensor type for the provided data buffer
+        *   \param mem_layout The memory layout for the provided data buffer
+        *   \throw SmartRedis::Exception if the fetched tensor does not
+        *          match the provided data buffer
+        */
+        void _unpack_tensor_reply(const std::string& get_key,
+                                  CommandReply& reply,
+                                  void* data,
+                                  const std::vector<size_t>& dims,
+                                  const SRTensorType type,
+                                  const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief Unpack fetched contiguous tensor data into memory
+        *          provided by the caller, after checking the provided
+        *          type and dimensions against the fetched tensor
+        *   \param get_key The database key of the tensor
+        *   \param fetched_dims The dimensions of the fetched tensor
+        *   \param fetched_type The type of the fetched tensor
+        *   \param blob The contiguous data of the fetched tensor
+        *   \param data A buffer into which to place tensor data
+        *   \param dims The dimensions for the provided data buffer
+        *   \param type The tensor type for the provided data buffer
+        *   \param mem_layout The memory layout for the provided data buffer
+        *   \throw SmartRedis::Exception if the fetched tensor does not
+        *          match the provided data buffer
+        */
+        void _unpack_tensor_data(const std::string& get_key,
+                                 const std::vector<size_t>& fetched_dims,
+                                 const SRTensorType fetched_type,
+                                 std::string_view blob,
+                                 void* data,
+                                 const std::vector<size_t>& dims,
+                                 const SRTensorType type,
+                                 const SRMemoryLayout mem_layout);
+
         /*!
         *   \brief The name of the hash field used to confirm that the
         *          DataSet placement operation was successfully completed.
         */
         inline static const std::string _DATASET_ACK_FIELD = ".COMPLETE";
 
+        /*!
+        *   \brief Lua script that renames the first half of KEYS to
+        *          the second half.  Every source key is checked
+        *          before any is renamed, so that either all of the
+        *          keys are moved or none are.
+        */
+        inline static const std::string _RENAME_KEYS_SCRIPT =
+            "local n = #KEYS / 2 "
+            "for i = 1, n do "
+            "if redis.call('EXISTS', KEYS[i]) == 0 then "
+            "return redis.error_reply('ERR no such key ' .. KEYS[i]) "
+            "end "
+            "end "
+            "for i = 1, n do "
+            "redis.call('RENAME', KEYS[i], KEYS[n + i]) "
+            "end "
+            "return redis.status_reply('OK')";
+
         friend class PyClient;
 
     private:
@@ -989,6 +1454,30 @@ class Client
         */
         TensorPack _tensor_memory;
 
+        /*!
+        *  \brief Queue of asynchronous requests and the I/O thread
+        *         that executes them. It is created on first use.
+        */
+        AsyncQueue* _async_queue;
+
+        /*!
+        *  \brief Cache of the replies of tensor, model and script
+        *         reads, or NULL if it is disabled
+        */
+        ReadCache* _read_cache;
+
+        /*!
+        *  \brief Cache of tensors shared with the other processes
+        *         of the compute node, or NULL if it was never used
+        */
+        SharedTensorCache* _shared_tensors;
+
+        /*!
+        *  \brief Flag determining whether tensors are read
+        *         through the shared tensor cache
+        */
+        bool _use_shared_tensors;
+
         /*!
         *  \brief The prefix for keys during placement
         */
@@ -1036,6 +1525,62 @@ class Client
         inline std::string _build_model_key(const std::string& name,
                                             const bool on_db);
 
+        /*!
+        * \brief Read a tensor through the read cache
+        * \param get_key The key of the tensor
+        * \returns The AI.TENSORGET META BLOB reply, or nullptr if
+        *          the cache is disabled or the tensor could not be
+        *          read through it
+        */
+        std::shared_ptr<CommandReply>
+        _get_cached_tensor(const std::string& get_key);
+
+        /*!
+        * \brief Read a model or script through the read cache
+        * \param get_key The key of the model or script
+        * \param command The command that reads the model or script
+        * \param field The field of the command that selects the
+        *              model or script contents
+        * \returns The reply of the command, or nullptr if the cache
+        *          is disabled or the model or script could not be
+        *          read through it
+        */
+        std::shared_ptr<CommandReply>
+        _get_cached_model_script(const std::string& get_key,
+                                 const std::string& command,
+                                 const std::string& field);
+
+        /*!
+        * \brief Read a tensor through the shared tensor cache
+        * \param get_key The key of the tensor
+        * \param blob Receives the contiguous tensor data
+        * \param dims Receives the dimensions of the tensor
+        * \param type Receives the type of the tensor
+        * \param hand_out Set if blob is handed out to the user
+        *                 rather than copied right away
+        * \returns True if the shared tensor cache is used and the
+        *          tensor was read through it
+        */
+        inline bool _get_shared_tensor(const std::string& get_key,
+                                       std::string_view& blob,
+                                       std::vector<size_t>& dims,
+                                       SRTensorType& type,
+                                       bool hand_out = false);
+
+        /*!
+        * \brief Remove a tensor from the caches after it
+        *        was written
+        * \param key The key of the tensor
+        */
+        inline void _invalidate_cached(const std::string& key);
+
+        /*!
+        * \brief Remove a model or script from the read cache
+        *        after it was written
+        * \param key The key of the model or script
+        */
+        inline void _invalidate_cached_model_script(const std::string& key);
+
         /*!
         *  \brief Build full formatted key of a dataset, based
         *         on current prefix settings.
@@ -1096,6 +1641,70 @@ class Client
         inline std::string _build_dataset_ack_key(const std::string& dataset_name,
                                                   const bool on_db);
 
+        /*!
+        *  \brief Create the key of the list used to wake clients
+        *         waiting in poll_dataset() for the dataset
+        *  \param dataset_name The name of the dataset
+        *  \param on_db Indicates whether the name refers to an entity which
+        *               is already in the database.
+        *  \returns A string of the key for the ready list
+        */
+        inline std::string _build_dataset_ready_key(const std::string& dataset_name,
+                                                    const bool on_db);
+
+        /*!
+        *   \brief Build the command to put a tensor whose data are
+        *          contiguous, referencing the data in place
+        *   \details The data buffer is not copied, so it must remain
+        *            valid until the command has been run.
+        *   \param cmd The command to build
+        *   \param key The database key of the tensor
+        *   \param data The contiguous tensor data
+        *   \param dims The dimensions of the data
+        *   \param type The data type of the tensor
+        *   \throw SmartRedis::Exception if the tensor description
+        *          is invalid
+        */
+        void _build_put_tensor_command(SingleKeyCommand& cmd,
+                                       const std::string& key,
+                                       void* data,
+                                       const std::vector<size_t>& dims,
+                                       const SRTensorType type);
+
+        /*!
+        *   \brief Add the fields of a put tensor command that
+        *          precede the tensor data
+        *   \param cmd The command to build
+        *   \param key The database key of the tensor
+        *   \param dims The dimensions of the data
+        *   \param type The data type of the tensor
+        *   \returns The number of bytes of tensor data
+        *   \throw SmartRedis::Exception if the tensor type
+        *          is invalid
+        */
+        size_t _add_put_tensor_fields(SingleKeyCommand& cmd,
+                                      const std::string& key,
+                                      const std::vector<size_t>& dims,
+                                      const SRTensorType type);
+
+        /*!
+        *   \brief Queue a task for execution on the asynchronous
+        *          request I/O thread
+        *   \param task The task to execute
+        *   \returns The future associated with the task
+        *   \throw SmartRedis::Exception if the queue cannot be created
+        */
+        std::future<void>
+        _submit_async(std::shared_ptr<std::packaged_task<void()>> task);
+
+        /*!
+        *   \brief Get the asynchronous request queue, starting its
+        *          I/O thread on first use
+        *   \returns The asynchronous request queue
+        *   \throw SmartRedis::Exception if the queue cannot be created
+        */
+        AsyncQueue& _get_async_queue();
+
         /*!
         *   \brief Append the Command associated with
         *          placing DataSet metadata in the database
@@ -1132,6 +1741,15 @@ class Client
         void _append_dataset_ack_command(CommandList& cmd_list,
                                          DataSet& dataset);
 
+        /*!
+        *   \brief Append the Commands that signal clients waiting
+        *          in poll_dataset() that the DataSet is complete
+        *   \param cmd_list The CommandList to append the commands to
+        *   \param dataset_name The name of the DataSet
+        */
+        void _append_dataset_ready_commands(CommandList& cmd_list,
+                                            const std::string& dataset_name);
+
         /*!
         *   \brief Put the metadata fields embedded in a
         *          CommandReply into the DataSet
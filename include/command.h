@@ -31,6 +31,7 @@
 
 #include "stdlib.h"
 #include "commandreply.h"
+#include "fieldarena.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -52,7 +53,10 @@ class RedisServer;
 *          while the Command.add_field_ptr() methods
 *          will only maintain a pointer to the field data.
 *          The Command.add_field_ptr() methods are ideal
-*          for large field values.
+*          for large field values.  Copied fields are
+*          placed in a FieldArena owned by the Command so
+*          that a typical Command needs a single allocation
+*          for all of its field data.
 */
 class Command
 {
@@ -165,6 +169,21 @@ class Command
         */
         void add_field_ptr(std::string_view field);
 
+        /*!
+        *   \brief Replace a field of the Command with a
+        *          pointer to other data.
+        *   \details As with add_field_ptr(), the data will
+        *            not be copied and must be valid up until
+        *            the execution of the Command.  This allows
+        *            a Command to be built once and executed
+        *            repeatedly with different data.
+        *   \param index The position of the field in the Command
+        *   \param field The new field data
+        *   \throw SmartRedis::RuntimeException if the index
+        *          is out of range or the field is a Command key
+        */
+        void set_field_ptr(size_t index, std::string_view field);
+
         /*!
         *   \brief Add fields to the Command
         *          from a vector of strings.
@@ -275,25 +294,42 @@ class Command
         std::vector<std::string_view> _fields;
 
         /*!
-        *   \brief All of the fields whose memory was
-                   allocated by Command, along with
-                   their associated index in _fields
+        *   \brief The memory of all of the fields
+        *          that were copied into the Command
+        */
+        FieldArena _arena;
+
+        /*!
+        *   \brief The index in _fields of each distinct
+        *          Command key, in the order they were added
         */
-        std::vector<std::pair<char*, size_t> > _local_fields;
+        std::vector<size_t> _key_indices;
 
         /*!
-        *   \brief All of the fields whose memory was not
-        *          allocated by Command, along with their
-        *          associated index in _fields
+        *   \brief The number of fields reserved in _fields
+        *          when the first field is added
+        */
+        static constexpr size_t _INITIAL_FIELD_CAPACITY = 8;
+
+        /*!
+        *   \brief Copy a field into the Command arena
+        *          and add it to the Command
+        *   \param field The field data
+        *   \param field_size The length of the field data
+        *   \param is_key Boolean indicating if the field
+        *                 should be treated as a key for the
+        *                 Command
         */
-        std::vector<std::pair<char*, size_t> > _ptr_fields;
+        void _add_local_field(const char* field,
+                              size_t field_size,
+                              bool is_key);
 
         /*!
-        *   \brief Unordered map of std::string_view to
-        *          the index of _fields and _local_fields
-        *          for the std::string_view
+        *   \brief Record a field as a Command key if an equal
+        *          key has not already been recorded
+        *   \param index The index of the field in _fields
         */
-        std::unordered_map<std::string_view, size_t> _cmd_keys;
+        void _add_key_index(size_t index);
 
         /*!
         *   \brief Helper function for emptying the Command
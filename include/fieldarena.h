@@ -0,0 +1,164 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_FIELDARENA_H
+#define SMARTREDIS_FIELDARENA_H
+
+#include <cstddef>
+
+///@file
+
+namespace SmartRedis {
+
+/*!
+*   \brief  The FieldArena class is a bump allocator
+*           for the field data copied into a Command.
+*   \details Memory is handed out sequentially from a
+*            block, and a larger block is added when the
+*            current block is full.  Blocks are never moved,
+*            so pointers into the arena stay valid until
+*            the arena is cleared or destroyed, including
+*            after the arena itself is moved.  All of the
+*            memory is released at once.
+*/
+class FieldArena
+{
+    public:
+
+        /*!
+        *   \brief Default FieldArena constructor
+        */
+        FieldArena() = default;
+
+        /*!
+        *   \brief FieldArena copy constructor is not allowed
+        *   \param arena The FieldArena to copy for construction
+        */
+        FieldArena(const FieldArena& arena) = delete;
+
+        /*!
+        *   \brief FieldArena move constructor
+        *   \param arena The FieldArena to move for construction
+        */
+        FieldArena(FieldArena&& arena);
+
+        /*!
+        *   \brief FieldArena copy assignment operator is not allowed
+        *   \param arena The FieldArena to copy for assignment
+        */
+        FieldArena& operator=(const FieldArena& arena) = delete;
+
+        /*!
+        *   \brief FieldArena move assignment operator
+        *   \param arena The FieldArena to move for assignment
+        *   \returns The FieldArena that has been assigned
+        */
+        FieldArena& operator=(FieldArena&& arena);
+
+        /*!
+        *   \brief FieldArena destructor
+        */
+        ~FieldArena();
+
+        /*!
+        *   \brief Allocate memory from the arena
+        *   \param n_bytes The number of bytes to allocate
+        *   \returns A pointer to the allocated memory
+        *   \throw SmartRedis::BadAllocException if a new
+        *          block cannot be allocated
+        */
+        char* allocate(size_t n_bytes);
+
+        /*!
+        *   \brief Make sure that the next n_bytes of allocations
+        *          are served from a single block
+        *   \param n_bytes The number of bytes to reserve
+        *   \throw SmartRedis::BadAllocException if a new
+        *          block cannot be allocated
+        */
+        void reserve(size_t n_bytes);
+
+        /*!
+        *   \brief Check whether memory was allocated from the arena
+        *   \param ptr The pointer to check
+        *   \returns True if ptr points into the arena
+        */
+        bool contains(const char* ptr) const;
+
+        /*!
+        *   \brief Release all of the memory of the arena
+        */
+        void clear();
+
+    private:
+
+        /*!
+        *   \brief The header at the start of each block,
+        *          which is followed by the block memory
+        */
+        struct Block {
+            Block* next;
+            size_t capacity;
+        };
+
+        /*!
+        *   \brief The size of the first block in bytes, which
+        *          fits the fields of typical Command
+        */
+        static constexpr size_t _FIRST_BLOCK_SIZE = 256;
+
+        /*!
+        *   \brief The most recently added block, which is
+        *          linked to the blocks added before it
+        */
+        Block* _head = NULL;
+
+        /*!
+        *   \brief The number of bytes used in the head block
+        */
+        size_t _used = 0;
+
+        /*!
+        *   \brief Add a block with room for at least n_bytes
+        *   \param n_bytes The number of bytes needed
+        *   \throw SmartRedis::BadAllocException if the block
+        *          cannot be allocated
+        */
+        void _add_block(size_t n_bytes);
+
+        /*!
+        *   \brief Get the memory of a block
+        *   \param block The block
+        *   \returns A pointer to the first byte after the header
+        */
+        static inline char* _block_data(Block* block);
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_FIELDARENA_H
@@ -0,0 +1,173 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_LAYOUTTRANSPOSE_H
+#define SMARTREDIS_LAYOUTTRANSPOSE_H
+
+#include <vector>
+#include <thread>
+#include <functional>
+#include <system_error>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include "srexception.h"
+
+namespace SmartRedis {
+
+/*!
+*   \brief  The LayoutTranspose class converts tensor data
+*           between row major (c-style) and column major
+*           (fortran-style) memory layouts.
+*   \details Converting between the two layouts reverses the
+*            order of the tensor axes.  The conversion is done
+*            as a cache-blocked transpose of the first and last
+*            axes for every position of the middle axes, so both
+*            the reads and the writes stay within a small tile.
+*            The tile loops have unit stride on the destination
+*            so that they can be vectorized by the compiler.
+*            Tensors with at least _PARALLEL_MIN_VALUES values are
+*            split across the number of threads given by the
+*            SR_TRANSPOSE_THREADS environment variable (one
+*            thread by default).
+*   \tparam T The data type of the tensor
+*/
+template <class T>
+class LayoutTranspose {
+
+    public:
+
+    /*!
+    *   \brief Copy a row major memory space into a
+    *          column major memory space
+    *   \param f_data The column major destination
+    *   \param c_data The row major source
+    *   \param dims The dimensions of the tensor
+    *   \throw SmartRedis::RuntimeException if either
+    *          buffer is NULL
+    */
+    static void c_to_f(T* f_data,
+                       const T* c_data,
+                       const std::vector<size_t>& dims);
+
+    /*!
+    *   \brief Copy a column major memory space into a
+    *          row major memory space
+    *   \param c_data The row major destination
+    *   \param f_data The column major source
+    *   \param dims The dimensions of the tensor
+    *   \throw SmartRedis::RuntimeException if either
+    *          buffer is NULL
+    */
+    static void f_to_c(T* c_data,
+                       const T* f_data,
+                       const std::vector<size_t>& dims);
+
+    private:
+
+    /*!
+    *   \brief Number of values along each side of a tile
+    */
+    static constexpr size_t _TILE = 32;
+
+    /*!
+    *   \brief Minimum number of tensor values before the
+    *          conversion is split across threads
+    */
+    static constexpr size_t _PARALLEL_MIN_VALUES = 1 << 22;
+
+    /*!
+    *   \brief Environment variable for the number of threads
+    *          used to convert large tensors
+    */
+    inline static const char* _THREADS_ENV_VAR = "SR_TRANSPOSE_THREADS";
+
+    /*!
+    *   \brief Copy a row major memory space into a row
+    *          major memory space with the axes reversed
+    *   \param dst The destination memory space
+    *   \param src The source memory space
+    *   \param src_dims The row major dimensions of the source
+    */
+    static void _reverse_axes(T* dst,
+                              const T* src,
+                              const std::vector<size_t>& src_dims);
+
+    /*!
+    *   \brief Transpose a range of rows of the first and last
+    *          axes for a range of positions of the middle axes
+    *   \details Work items are numbered with the middle axes
+    *            position as the major index and the row tile
+    *            as the minor index.
+    *   \param dst The destination memory space
+    *   \param src The source memory space
+    *   \param src_dims The row major dimensions of the source
+    *   \param first_item The first work item to process
+    *   \param last_item One past the last work item to process
+    */
+    static void _transpose_items(T* dst,
+                                 const T* src,
+                                 const std::vector<size_t>& src_dims,
+                                 size_t first_item,
+                                 size_t last_item);
+
+    /*!
+    *   \brief Transpose a block of rows of a strided
+    *          two dimensional array one tile at a time
+    *   \param dst The destination of row 0, column 0
+    *   \param src The source of row 0, column 0
+    *   \param first_row The first row of the block
+    *   \param last_row One past the last row of the block
+    *   \param n_cols The number of columns
+    *   \param src_row_stride The source distance between rows
+    *   \param dst_col_stride The destination distance between
+    *                         columns
+    */
+    static inline void _transpose_rows(T* dst,
+                                       const T* src,
+                                       size_t first_row,
+                                       size_t last_row,
+                                       size_t n_cols,
+                                       size_t src_row_stride,
+                                       size_t dst_col_stride);
+
+    /*!
+    *   \brief Get the number of threads to use for the
+    *          conversion of a tensor
+    *   \param n_values The number of values in the tensor
+    *   \param n_items The number of available work items
+    *   \returns The number of threads to use
+    */
+    static size_t _n_threads(size_t n_values, size_t n_items);
+};
+
+#include "layouttranspose.tcc"
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_LAYOUTTRANSPOSE_H
@@ -0,0 +1,198 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_LAYOUTTRANSPOSE_TCC
+#define SMARTREDIS_LAYOUTTRANSPOSE_TCC
+
+// Copy a row major memory space into a column major memory space
+template <class T>
+void LayoutTranspose<T>::c_to_f(T* f_data,
+                                const T* c_data,
+                                const std::vector<size_t>& dims)
+{
+    _reverse_axes(f_data, c_data, dims);
+}
+
+// Copy a column major memory space into a row major memory space
+template <class T>
+void LayoutTranspose<T>::f_to_c(T* c_data,
+                                const T* f_data,
+                                const std::vector<size_t>& dims)
+{
+    // A column major memory space is a row major
+    // memory space with the dimensions reversed
+    std::vector<size_t> f_dims(dims.rbegin(), dims.rend());
+    _reverse_axes(c_data, f_data, f_dims);
+}
+
+// Copy a row major memory space with the axes reversed
+template <class T>
+void LayoutTranspose<T>::_reverse_axes(T* dst,
+                                       const T* src,
+                                       const std::vector<size_t>& src_dims)
+{
+    if (dst == NULL || src == NULL) {
+        throw SRRuntimeException("Invalid buffer supplied to "\
+                                 "LayoutTranspose");
+    }
+
+    // Axes of length one do not change the position of any
+    // value, so only the remaining axes need to be reversed
+    std::vector<size_t> dims;
+    size_t n_values = 1;
+    for (size_t i = 0; i < src_dims.size(); i++) {
+        n_values *= src_dims[i];
+        if (src_dims[i] > 1)
+            dims.push_back(src_dims[i]);
+    }
+    if (n_values == 0)
+        return;
+    if (dims.size() <= 1) {
+        std::memcpy(dst, src, n_values * sizeof(T));
+        return;
+    }
+
+    size_t n_row_tiles = (dims.front() + _TILE - 1) / _TILE;
+    size_t n_middle = n_values / (dims.front() * dims.back());
+    size_t n_items = n_middle * n_row_tiles;
+    size_t n_threads = _n_threads(n_values, n_items);
+    if (n_threads <= 1) {
+        _transpose_items(dst, src, dims, 0, n_items);
+        return;
+    }
+
+    // Split the work items evenly, with the calling thread
+    // processing the final share
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    size_t share = n_items / n_threads;
+    size_t extra = n_items % n_threads;
+    size_t first_item = 0;
+    for (size_t t = 0; t < n_threads; t++) {
+        size_t last_item = first_item + share + (t < extra ? 1 : 0);
+        if (t + 1 == n_threads) {
+            _transpose_items(dst, src, dims, first_item, last_item);
+        }
+        else {
+            try {
+                threads.emplace_back(_transpose_items, dst, src,
+                                     std::cref(dims), first_item, last_item);
+            }
+            catch (std::system_error& e) {
+                _transpose_items(dst, src, dims, first_item, last_item);
+            }
+        }
+        first_item = last_item;
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+}
+
+// Transpose the first and last axes for a range of work items
+template <class T>
+void LayoutTranspose<T>::_transpose_items(T* dst,
+                                          const T* src,
+                                          const std::vector<size_t>& src_dims,
+                                          size_t first_item,
+                                          size_t last_item)
+{
+    size_t n_dims = src_dims.size();
+    size_t n_rows = src_dims[0];
+    size_t n_cols = src_dims[n_dims - 1];
+    size_t n_row_tiles = (n_rows + _TILE - 1) / _TILE;
+
+    // The source is row major in src_dims and the
+    // destination is column major in src_dims
+    std::vector<size_t> src_strides(n_dims, 1);
+    std::vector<size_t> dst_strides(n_dims, 1);
+    for (size_t k = n_dims - 1; k > 0; k--)
+        src_strides[k - 1] = src_strides[k] * src_dims[k];
+    for (size_t k = 1; k < n_dims; k++)
+        dst_strides[k] = dst_strides[k - 1] * src_dims[k - 1];
+
+    for (size_t item = first_item; item < last_item; item++) {
+        size_t middle = item / n_row_tiles;
+        size_t row_tile = item % n_row_tiles;
+
+        size_t src_offset = 0;
+        size_t dst_offset = 0;
+        for (size_t k = n_dims - 2; k > 0; k--) {
+            size_t position = middle % src_dims[k];
+            middle /= src_dims[k];
+            src_offset += position * src_strides[k];
+            dst_offset += position * dst_strides[k];
+        }
+
+        size_t first_row = row_tile * _TILE;
+        size_t last_row = std::min(first_row + _TILE, n_rows);
+        _transpose_rows(dst + dst_offset, src + src_offset,
+                        first_row, last_row, n_cols,
+                        src_strides[0], dst_strides[n_dims - 1]);
+    }
+}
+
+// Transpose a block of rows of a strided two dimensional array
+template <class T>
+inline void LayoutTranspose<T>::_transpose_rows(T* dst,
+                                                const T* src,
+                                                size_t first_row,
+                                                size_t last_row,
+                                                size_t n_cols,
+                                                size_t src_row_stride,
+                                                size_t dst_col_stride)
+{
+    for (size_t first_col = 0; first_col < n_cols; first_col += _TILE) {
+        size_t last_col = std::min(first_col + _TILE, n_cols);
+        for (size_t c = first_col; c < last_col; c++) {
+            T* dst_col = dst + c * dst_col_stride;
+            const T* src_col = src + c;
+            for (size_t r = first_row; r < last_row; r++)
+                dst_col[r] = src_col[r * src_row_stride];
+        }
+    }
+}
+
+// Get the number of threads to use for the conversion of a tensor
+template <class T>
+size_t LayoutTranspose<T>::_n_threads(size_t n_values, size_t n_items)
+{
+    if (n_values < _PARALLEL_MIN_VALUES || n_items < 2)
+        return 1;
+
+    const char* env_val = std::getenv(_THREADS_ENV_VAR);
+    if (env_val == NULL)
+        return 1;
+
+    char* end = NULL;
+    long n_threads = std::strtol(env_val, &end, 10);
+    if (end == env_val || *end != '\0' || n_threads < 1)
+        return 1;
+    return std::min((size_t)n_threads, n_items);
+}
+
+#endif //SMARTREDIS_LAYOUTTRANSPOSE_TCC
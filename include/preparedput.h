@@ -0,0 +1,102 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_PREPAREDPUT_H
+#define SMARTREDIS_PREPAREDPUT_H
+
+#include <string>
+#include <cstdint>
+#include "singlekeycommand.h"
+
+///@file
+
+namespace SmartRedis {
+
+class Client;
+
+/*!
+*   \brief  The PreparedPut class holds a tensor put
+*           command that is built once by
+*           Client::prepare_put() and executed repeatedly
+*           by Client::put_tensor() with new data.
+*   \details The tensor key, type and dimension fields of
+*            the command and the hash slot of the key are
+*            computed when the PreparedPut is created, so
+*            each put only swaps in the data pointer.  The
+*            key is fixed at that time and is not affected
+*            by later changes to the Client key prefixes.
+*/
+class PreparedPut
+{
+    public:
+
+        /*!
+        *   \brief Default PreparedPut constructor.  The
+        *          PreparedPut cannot be used until it is
+        *          assigned the result of Client::prepare_put().
+        */
+        PreparedPut() = default;
+
+        /*!
+        *   \brief Get the database key of the tensor
+        *   \returns The database key of the tensor
+        */
+        const std::string& key() const
+        {
+            return _key;
+        }
+
+    private:
+
+        friend class Client;
+
+        /*!
+        *   \brief The put command, whose final field is
+        *          replaced with the data of each put
+        */
+        SingleKeyCommand _cmd;
+
+        /*!
+        *   \brief The database key of the tensor
+        */
+        std::string _key;
+
+        /*!
+        *   \brief The number of bytes of tensor data
+        */
+        size_t _n_bytes = 0;
+
+        /*!
+        *   \brief The hash slot of the tensor key
+        */
+        uint16_t _hash_slot = 0;
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_PREPAREDPUT_H
@@ -0,0 +1,106 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_PREPAREDUNPACK_H
+#define SMARTREDIS_PREPAREDUNPACK_H
+
+#include <string>
+#include <cstdint>
+#include <vector>
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+class Client;
+
+/*!
+*   \brief  The PreparedUnpack class describes a tensor
+*           retrieval into caller memory that is set up
+*           once by Client::prepare_unpack() and executed
+*           repeatedly by Client::unpack_tensor().
+*   \details The tensor key, the hash slot of the key and
+*            the checked description of the memory space are
+*            computed when the PreparedUnpack is created.  The
+*            key is fixed at that time and is not affected by
+*            later changes to the Client key prefixes.
+*/
+class PreparedUnpack
+{
+    public:
+
+        /*!
+        *   \brief Default PreparedUnpack constructor.  The
+        *          PreparedUnpack cannot be used until it is
+        *          assigned the result of Client::prepare_unpack().
+        */
+        PreparedUnpack() = default;
+
+        /*!
+        *   \brief Get the database key of the tensor
+        *   \returns The database key of the tensor
+        */
+        const std::string& key() const
+        {
+            return _key;
+        }
+
+    private:
+
+        friend class Client;
+
+        /*!
+        *   \brief The database key of the tensor
+        */
+        std::string _key;
+
+        /*!
+        *   \brief The dimensions of the memory space
+        */
+        std::vector<size_t> _dims;
+
+        /*!
+        *   \brief The tensor type of the memory space
+        */
+        SRTensorType _type = SRTensorTypeInvalid;
+
+        /*!
+        *   \brief The memory layout of the memory space
+        */
+        SRMemoryLayout _mem_layout = SRMemLayoutInvalid;
+
+        /*!
+        *   \brief The hash slot of the tensor key
+        */
+        uint16_t _hash_slot = 0;
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_PREPAREDUNPACK_H
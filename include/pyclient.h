@@ -80,6 +80,19 @@ class PyClient
                         std::string& type,
                         py::array data);
 
+        /*!
+        *   \brief Put multiple tensors into the database
+        *          with pipelined commands
+        *   \param keys The key to associate with each tensor
+        *               in the database
+        *   \param types The data type of each tensor
+        *   \param data Numpy array with Pybind* for each tensor
+        *   \throw RuntimeException for all client errors
+        */
+        void put_tensors(std::vector<std::string>& keys,
+                         std::vector<std::string>& types,
+                         std::vector<py::array>& data);
+
         /*!
         *   \brief  Retrieve a tensor from the database.
         *   \details The memory of the data pointer used
@@ -97,6 +110,17 @@ class PyClient
         */
         py::array get_tensor(const std::string& key);
 
+        /*!
+        *   \brief  Retrieve multiple tensors from the database
+        *           with pipelined commands.
+        *   \details Each returned Numpy array owns the memory
+        *            of its tensor data.
+        *   \param keys The names used to reference the tensors
+        *   \returns A list with a Numpy array for each key
+        *   \throw RuntimeException for all client errors
+        */
+        py::list get_tensors(std::vector<std::string>& keys);
+
         /*!
         *   \brief delete a tensor stored in the database
         *   \param key The key of tensor to delete
@@ -558,6 +582,14 @@ class PyClient
         */
         Client* _client;
 
+        /*!
+        *   \brief Build a Numpy array that takes ownership
+        *          of a TensorBase object
+        *   \param tensor The TensorBase to wrap
+        *   \returns The Numpy array viewing the tensor data
+        */
+        py::array _tensor_to_array(TensorBase* tensor);
+
 };
 
 } //namespace SmartRedis
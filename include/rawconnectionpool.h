@@ -0,0 +1,127 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_RAWCONNECTIONPOOL_H
+#define SMARTREDIS_RAWCONNECTIONPOOL_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <hiredis/hiredis.h>
+
+///@file
+
+namespace SmartRedis {
+
+class RawConnectionPool;
+
+/*!
+*   \brief The RawConnectionPool class keeps hiredis connections to
+*          database nodes for the requests that need to work on the
+*          hiredis context itself.
+*   \details redis-plus-plus does not expose the hiredis context of
+*            its connections, so requests that write to the socket
+*            directly or replace the reply reader run on
+*            connections from this pool instead.  Connections are
+*            opened on first use and kept idle between requests.
+*            A connection is only returned to the pool if it has
+*            no error, so a connection that may hold a partial
+*            command or unread replies is never reused.
+*/
+class RawConnectionPool
+{
+    public:
+
+        /*!
+        *   \brief RawConnectionPool default constructor
+        */
+        RawConnectionPool() = default;
+
+        /*!
+        *   \brief RawConnectionPool copy constructor is not allowed
+        *   \param pool The RawConnectionPool to copy for construction
+        */
+        RawConnectionPool(const RawConnectionPool& pool) = delete;
+
+        /*!
+        *   \brief RawConnectionPool copy assignment is not allowed
+        *   \param pool The RawConnectionPool to copy for assignment
+        */
+        RawConnectionPool& operator=(const RawConnectionPool& pool) = delete;
+
+        /*!
+        *   \brief RawConnectionPool destructor.  Closes the idle
+        *          connections.
+        */
+        ~RawConnectionPool();
+
+        /*!
+        *   \brief Take a connection to a database node from the
+        *          pool, opening one if none is idle
+        *   \param address The address of the database node, either
+        *                  host:port or the path of a Unix domain
+        *                  socket
+        *   \returns The hiredis context of the connection
+        *   \throw sw::redis::IoError if no connection can be opened
+        */
+        redisContext* acquire(const std::string& address);
+
+        /*!
+        *   \brief Give a connection back to the pool.  A connection
+        *          with an error is closed instead.
+        *   \param address The address the connection was acquired for
+        *   \param context The hiredis context of the connection
+        */
+        void release(const std::string& address, redisContext* context);
+
+        /*!
+        *   \brief Open a hiredis connection to a database node
+        *   \param address The address of the database node, either
+        *                  host:port or the path of a Unix domain
+        *                  socket
+        *   \returns The hiredis context, or NULL on failure
+        */
+        static redisContext* connect(const std::string& address);
+
+    private:
+
+        /*!
+        *   \brief The idle connections, indexed by address
+        */
+        std::unordered_map<std::string, std::vector<redisContext*>> _idle;
+
+        /*!
+        *   \brief Guards _idle
+        */
+        std::mutex _mutex;
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_RAWCONNECTIONPOOL_H
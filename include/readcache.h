@@ -0,0 +1,335 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_READCACHE_H
+#define SMARTREDIS_READCACHE_H
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <sw/redis++/redis++.h>
+#include "command.h"
+#include "commandreply.h"
+
+///@file
+
+namespace SmartRedis {
+
+class ReadCache;
+
+/*!
+*   \brief The ReadCache class keeps the replies of read commands
+*          in a least recently used cache with a memory budget.
+*   \details Reads that miss the cache are sent on a connection
+*            for which client side tracking (CLIENT TRACKING) is
+*            enabled, so the server remembers the keys that were
+*            read and announces every later change to them.  The
+*            announcements are redirected to a second connection
+*            per database node that is subscribed to the
+*            __redis__:invalidate channel, where a background
+*            thread evicts the affected keys.  If either
+*            connection to a node is lost, no announcement can be
+*            trusted to arrive, so the whole cache is cleared.
+*            Any failure to read through the cache is reported by
+*            returning no reply, and the caller is expected to
+*            fall back to its usual connection.
+*/
+class ReadCache
+{
+    public:
+
+        /*!
+        *   \brief ReadCache constructor
+        *   \param max_bytes The memory budget of the cached
+        *                    replies in bytes
+        */
+        ReadCache(size_t max_bytes);
+
+        /*!
+        *   \brief ReadCache copy constructor is not allowed
+        *   \param cache The ReadCache to copy for construction
+        */
+        ReadCache(const ReadCache& cache) = delete;
+
+        /*!
+        *   \brief ReadCache copy assignment is not allowed
+        *   \param cache The ReadCache to copy for assignment
+        */
+        ReadCache& operator=(const ReadCache& cache) = delete;
+
+        /*!
+        *   \brief ReadCache destructor.  Stops the invalidation
+        *          threads and closes the tracked connections.
+        */
+        ~ReadCache();
+
+        /*!
+        *   \brief Get the reply of a read command on a key,
+        *          running the command on a tracked connection
+        *          if the reply is not cached
+        *   \param address The address of the database node that
+        *                  holds the key (host:port or a unix
+        *                  socket path)
+        *   \param key The key read by the command
+        *   \param cmd The read command
+        *   \returns The reply of the command, or nullptr if the
+        *            command could not be run on a tracked
+        *            connection or replied with an error
+        */
+        std::shared_ptr<CommandReply> get(const std::string& address,
+                                          const std::string& key,
+                                          const Command& cmd);
+
+        /*!
+        *   \brief Remove a key from the cache.  Replies to reads
+        *          of the key that are in flight are not cached.
+        *   \param key The key to remove
+        */
+        void invalidate(const std::string& key);
+
+        /*!
+        *   \brief Remove every key from the cache.  Replies to
+        *          reads that are in flight are not cached.
+        */
+        void clear();
+
+        /*!
+        *   \brief Get the number of bytes held by cached replies
+        *   \returns The number of bytes held by cached replies
+        */
+        size_t n_bytes();
+
+        /*!
+        *   \brief Get the number of cached replies
+        *   \returns The number of cached replies
+        */
+        size_t n_entries();
+
+    private:
+
+        /*!
+        *   \brief A cached reply and its place in the LRU order
+        */
+        struct CacheEntry
+        {
+            /*!
+            *   \brief The key read by the command
+            */
+            std::string key;
+
+            /*!
+            *   \brief The reply of the command
+            */
+            std::shared_ptr<CommandReply> reply;
+
+            /*!
+            *   \brief The number of bytes held by the reply
+            */
+            size_t n_bytes;
+        };
+
+        /*!
+        *   \brief The connections used to read from a database
+        *          node with client side tracking
+        */
+        struct TrackedNode
+        {
+            /*!
+            *   \brief The connection reads are sent on.  Tracking
+            *          is enabled on it, with announcements
+            *          redirected to the listener.
+            */
+            redisContext* data = NULL;
+
+            /*!
+            *   \brief The connection subscribed to the
+            *          __redis__:invalidate channel
+            */
+            redisContext* listener = NULL;
+
+            /*!
+            *   \brief Serializes the use of the data connection
+            *          and guards the closing of both connections
+            */
+            std::mutex data_mutex;
+
+            /*!
+            *   \brief The thread reading the listener connection
+            */
+            std::thread thread;
+
+            /*!
+            *   \brief Whether both connections are usable.  Once
+            *          cleared, the node is replaced on the next
+            *          read that misses the cache.
+            */
+            std::atomic<bool> alive{false};
+        };
+
+        /*!
+        *   \brief Insert a reply at the front of the LRU order and
+        *          evict the least recently used replies until the
+        *          memory budget is met.  The caller must hold _mutex.
+        *   \param key The key read by the command
+        *   \param reply The reply of the command
+        *   \param n_bytes The number of bytes held by the reply
+        */
+        void _insert(const std::string& key,
+                     std::shared_ptr<CommandReply> reply,
+                     size_t n_bytes);
+
+        /*!
+        *   \brief Remove every key from the cache.  The caller
+        *          must hold _mutex.
+        */
+        void _clear();
+
+        /*!
+        *   \brief Run a command on the tracked connection of a node
+        *   \param address The address of the database node
+        *   \param cmd The command to run
+        *   \returns The reply of the command, or NULL if the
+        *            connection failed
+        */
+        redisReply* _fetch(const std::string& address, const Command& cmd);
+
+        /*!
+        *   \brief Get the tracked connections of a node, opening
+        *          them if they are not open yet or were lost
+        *   \param address The address of the database node
+        *   \returns The tracked connections of the node, or
+        *            nullptr if they could not be opened
+        */
+        std::shared_ptr<TrackedNode> _get_node(const std::string& address);
+
+        /*!
+        *   \brief Open the tracked connections of a node and
+        *          start the thread that reads its announcements
+        *   \param node The node to open the connections of
+        *   \param address The address of the database node
+        *   \returns True if the connections were opened
+        */
+        bool _open_node(TrackedNode& node, const std::string& address);
+
+        /*!
+        *   \brief Stop the thread of a node and close its
+        *          connections
+        *   \param node The node to close
+        */
+        static void _close_node(TrackedNode& node);
+
+        /*!
+        *   \brief Read invalidation announcements from the
+        *          listener connection of a node until the
+        *          connection is closed
+        *   \param node The node to read the announcements of
+        */
+        void _listen(TrackedNode* node);
+
+        /*!
+        *   \brief Estimate the number of bytes held by a reply
+        *   \param reply The reply
+        *   \returns The number of bytes held by the reply
+        */
+        static size_t _reply_bytes(const redisReply* reply);
+
+        /*!
+        *   \brief The memory budget of the cached replies in bytes
+        */
+        size_t _max_bytes;
+
+        /*!
+        *   \brief The number of bytes held by cached replies
+        */
+        size_t _n_bytes;
+
+        /*!
+        *   \brief The cached replies, most recently used first
+        */
+        std::list<CacheEntry> _lru;
+
+        /*!
+        *   \brief The position of each cached key in _lru
+        */
+        std::unordered_map<std::string,
+                           std::list<CacheEntry>::iterator> _entries;
+
+        /*!
+        *   \brief The number of reads in flight for each key
+        *          that is not cached
+        */
+        std::unordered_map<std::string, size_t> _n_pending;
+
+        /*!
+        *   \brief The keys invalidated while reads of them were
+        *          in flight.  The replies of those reads may
+        *          predate the change and are not cached.
+        */
+        std::unordered_set<std::string> _stale;
+
+        /*!
+        *   \brief Incremented every time the whole cache is
+        *          cleared, so that the replies of reads in flight
+        *          at the time are not cached
+        */
+        uint64_t _epoch;
+
+        /*!
+        *   \brief Guards the cached replies and the in flight
+        *          read bookkeeping
+        */
+        std::mutex _mutex;
+
+        /*!
+        *   \brief The tracked connections of each database node,
+        *          indexed by address
+        */
+        std::unordered_map<std::string,
+                           std::shared_ptr<TrackedNode>> _nodes;
+
+        /*!
+        *   \brief Guards _nodes
+        */
+        std::mutex _nodes_mutex;
+
+        /*!
+        *   \brief The name of the channel the server publishes
+        *          invalidation announcements on
+        */
+        inline static const std::string _INVALIDATE_CHANNEL =
+            "__redis__:invalidate";
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_READCACHE_H
@@ -93,6 +93,17 @@ class Redis : public RedisServer
         */
         virtual CommandReply run(SingleKeyCommand& cmd);
 
+       /*!
+        *   \brief Run a SingleKeyCommand on the server.  All
+        *          keys are held by a single server, so the hash
+        *          slot is not used.
+        *   \param cmd The SingleKeyCommand to run
+        *   \param hash_slot The hash slot of the Command key
+        *   \returns The CommandReply from the
+        *            command execution
+        */
+        virtual CommandReply run(SingleKeyCommand& cmd, uint16_t hash_slot);
+
         /*!
         *   \brief Run a MultiKeyCommand on the server
         *   \param cmd The MultiKeyCommand to run
@@ -127,8 +138,9 @@ class Redis : public RedisServer
 
         /*!
         *   \brief Run multiple single-key or single-hash slot
-        *          Command on the server.  Each Command in the
-        *          CommandList is run sequentially.
+        *          Command on the server.  The Command in the
+        *          CommandList are pipelined to the server and
+        *          the replies are returned in CommandList order.
         *   \param cmd The CommandList containing multiple
         *              single-key or single-hash
         *              slot Comand to run
@@ -171,6 +183,42 @@ class Redis : public RedisServer
          */
         virtual bool is_addressable(const std::string& address, const uint64_t& port);
 
+        /*!
+         *  \brief Check if two keys can be addressed by a single
+         *         multi-key command.  All keys are co-located on
+         *         a single server.
+         *  \param key The first key
+         *  \param other_key The second key
+         *  \return True
+         */
+        virtual bool is_colocated(const std::string& key,
+                                  const std::string& other_key);
+
+        /*!
+         *  \brief Get the hash slot of a key.  All keys are
+         *         held by a single server, so every key is
+         *         in hash slot 0.
+         *  \param key The key
+         *  \return 0
+         */
+        virtual uint16_t get_hash_slot(const std::string& key);
+
+        /*!
+        *   \brief Get the address of the database node that
+        *          holds a key
+        *   \param key The key
+        *   \returns The address of the database node
+        */
+        virtual std::string get_key_address(const std::string& key);
+
+        /*!
+        *   \brief Get the key that get_model() and get_script()
+        *          read a model or script from
+        *   \param key The key associated with the model or script
+        *   \returns The key itself
+        */
+        virtual std::string get_model_script_key(const std::string& key);
+
         /*!
         *   \brief Put a Tensor on the server
         *   \param tensor The Tensor to put on the server
@@ -187,6 +235,32 @@ class Redis : public RedisServer
         */
         virtual CommandReply get_tensor(const std::string& key);
 
+        /*!
+        *   \brief Get a Tensor from the server, writing its data
+        *          into the memory space of a TensorBlobSink while
+        *          the reply is read
+        *   \param key The name of the tensor to retrieve
+        *   \param sink The destination of the tensor data
+        *   \returns The CommandReply from the get tensor server
+        *            command execution
+        */
+        virtual CommandReply get_tensor(const std::string& key,
+                                        TensorBlobSink& sink);
+
+        /*!
+        *   \brief Get a Tensor from the server, writing its data
+        *          into the memory space of a TensorBlobSink while
+        *          the reply is read.  The hash slot is not used.
+        *   \param key The name of the tensor to retrieve
+        *   \param sink The destination of the tensor data
+        *   \param hash_slot The hash slot of the key
+        *   \returns The CommandReply from the get tensor server
+        *            command execution
+        */
+        virtual CommandReply get_tensor(const std::string& key,
+                                        TensorBlobSink& sink,
+                                        uint16_t hash_slot);
+
         /*!
         *   \brief Rename a tensor in the database
         *   \param key The original key for the tensor
@@ -207,22 +281,24 @@ class Redis : public RedisServer
 
         /*!
         *   \brief Copy a tensor from the source key to
-        *          the destination key
+        *          the destination key.  The tensor data does
+        *          not leave the server.
         *   \param src_key The source key for the tensor copy
         *   \param dest_key The destination key for the tensor copy
-        *   \returns The CommandReply from executing the COPY
-        *            command
+        *   \returns The CommandReply from executing the server-side
+        *            copy command
         */
         virtual CommandReply copy_tensor(const std::string& src_key,
                                          const std::string& dest_key);
 
         /*!
         *   \brief Copy a vector of tensors from source keys
-        *          to destination keys
+        *          to destination keys.  The copies are pipelined
+        *          and the tensor data does not leave the server.
         *   \param src Vector of source keys
         *   \param dest Vector of destination keys
-        *   \returns The CommandReply from the last put command
-        *            associated with the tensor copy
+        *   \returns The CommandReply from the last server-side
+        *            copy command
         */
         virtual CommandReply copy_tensors(const std::vector<std::string>& src,
                                           const std::vector<std::string>& dest);
@@ -29,7 +29,12 @@
 #ifndef SMARTREDIS_CPP_CLUSTER_H
 #define SMARTREDIS_CPP_CLUSTER_H
 
-#include <unordered_set>
+#include <unordered_map>
+#include <future>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <memory>
 #include "redisserver.h"
 #include "dbnode.h"
 #include "nonkeyedcommand.h"
@@ -100,6 +105,16 @@ class RedisCluster : public RedisServer
         */
         virtual CommandReply run(SingleKeyCommand& cmd);
 
+        /*!
+        *   \brief Run a single-key Command whose key is in a
+        *          known hash slot
+        *   \param cmd The single-key Comand to run
+        *   \param hash_slot The hash slot of the Command key
+        *   \returns The CommandReply from the
+        *            command execution
+        */
+        virtual CommandReply run(SingleKeyCommand& cmd, uint16_t hash_slot);
+
         /*!
         *   \brief Run a multi-key Command on the server
         *   \param cmd The multi-key Comand to run
@@ -138,8 +153,16 @@ class RedisCluster : public RedisServer
 
         /*!
         *   \brief Run multiple single-key or single-hash slot
-        *          Command on the server.  Each Command in the
-        *          CommandList is run sequentially.
+        *          Command on the server.  The Command in the
+        *          CommandList are grouped by db node and each
+        *          group is pipelined to its db node.  Every
+        *          pipeline is written before any reply is read,
+        *          so the db nodes work on their groups
+        *          concurrently without a thread per group.
+        *          The replies are returned in CommandList order.
+        *          Command that are redirected because a hash slot
+        *          has moved are run again on the db node that now
+        *          serves it.
         *   \param cmd The CommandList containing multiple
         *              single-key or single-hash
         *              slot Command to run
@@ -182,6 +205,43 @@ class RedisCluster : public RedisServer
          */
         virtual bool is_addressable(const std::string& address, const uint64_t& port);
 
+        /*!
+         *  \brief Check if two keys can be addressed by a single
+         *         multi-key command.  Redis cluster only allows this
+         *         for keys in the same hash slot.
+         *  \param key The first key
+         *  \param other_key The second key
+         *  \return True if the keys are in the same hash slot
+         */
+        virtual bool is_colocated(const std::string& key,
+                                  const std::string& other_key);
+
+        /*!
+         *  \brief Get the hash slot of a key
+         *  \param key The key
+         *  \return The hash slot of the key
+         */
+        virtual uint16_t get_hash_slot(const std::string& key);
+
+        /*!
+        *   \brief Get the address of the database node that
+        *          holds a key
+        *   \param key The key
+        *   \returns The address of the database node (host:port)
+        */
+        virtual std::string get_key_address(const std::string& key);
+
+        /*!
+        *   \brief Get the key that get_model() and get_script()
+        *          read a model or script from.  Models and scripts
+        *          are set on every database node and read from the
+        *          node that holds hash slot 0.
+        *   \param key The key associated with the model or script
+        *   \returns The key prefixed for the node that holds
+        *            hash slot 0
+        */
+        virtual std::string get_model_script_key(const std::string& key);
+
         /*!
         *   \brief Put a Tensor on the server
         *   \param tensor The Tensor to put on the server
@@ -198,6 +258,32 @@ class RedisCluster : public RedisServer
         */
         virtual CommandReply get_tensor(const std::string& key);
 
+        /*!
+        *   \brief Get a Tensor from the server, writing its data
+        *          into the memory space of a TensorBlobSink while
+        *          the reply is read
+        *   \param key The name of the tensor to retrieve
+        *   \param sink The destination of the tensor data
+        *   \returns The CommandReply from the get tensor server
+        *            command execution
+        */
+        virtual CommandReply get_tensor(const std::string& key,
+                                        TensorBlobSink& sink);
+
+        /*!
+        *   \brief Get a Tensor from the server, writing its data
+        *          into the memory space of a TensorBlobSink while
+        *          the reply is read
+        *   \param key The name of the tensor to retrieve
+        *   \param sink The destination of the tensor data
+        *   \param hash_slot The hash slot of the key
+        *   \returns The CommandReply from the get tensor server
+        *            command execution
+        */
+        virtual CommandReply get_tensor(const std::string& key,
+                                        TensorBlobSink& sink,
+                                        uint16_t hash_slot);
+
         /*!
         *   \brief Rename a tensor in the database
         *   \param key The original key for the tensor
@@ -220,26 +306,27 @@ class RedisCluster : public RedisServer
 
         /*!
         *   \brief Copy a tensor from the source key to
-        *          the destination key
+        *          the destination key.  When both keys are in
+        *          the same hash slot, the tensor data does not
+        *          leave the server; otherwise the tensor is
+        *          retrieved and put back by the client.
         *   \param src_key The source key for the tensor copy
         *   \param dest_key The destination key for the tensor copy
         *   \returns The CommandReply from the last Command
         *            execution in the copying of the tensor.
-        *            In the case of RedisCluster, this is
-        *            the CommandReply from a put_tensor commands.
         */
         virtual CommandReply copy_tensor(const std::string& src_key,
                                          const std::string& dest_key);
 
         /*!
         *   \brief Copy a vector of tensors from source keys
-        *          to destination keys
+        *          to destination keys.  Copies within a hash slot
+        *          are pipelined server-side copies and the
+        *          remaining copies are made through the client.
         *   \param src Vector of source keys
         *   \param dest Vector of destination keys
         *   \returns The CommandReply from the last Command
-        *            execution in the copying of the tensor.
-        *            Different implementations may have different
-        *            sequences of commands.
+        *            execution in the copying of the tensors.
         */
         virtual CommandReply copy_tensors(const std::vector<std::string>& src,
                                           const std::vector<std::string>& dest);
@@ -362,6 +449,21 @@ class RedisCluster : public RedisServer
         */
         std::string _get_crc16_prefix(uint64_t hash_slot);
 
+        /*!
+        *   \brief Remap the cluster on a background thread unless
+        *          a remap is already running
+        */
+        void _refresh_topology();
+
+        /*!
+        *   \brief Get the DBNode that serves a hash slot
+        *   \param hash_slot The hash slot
+        *   \returns A copy of the DBNode, which stays valid
+        *            if the cluster is remapped
+        *   \throw RuntimeException if no DBNode serves the hash slot
+        */
+        DBNode _get_slot_node(uint16_t hash_slot);
+
     private:
 
         /*!
@@ -375,19 +477,199 @@ class RedisCluster : public RedisServer
         std::vector<DBNode> _db_nodes;
 
         /*!
-        *   \brief Prefix of the most recently used DBNode
+        *   \brief The index into _db_nodes of the DBNode that serves
+        *          each of the hash slots of the cluster
+        */
+        std::vector<uint16_t> _slot_nodes;
+
+        /*!
+        *   \brief Guards _db_nodes, _slot_nodes and _address_node_map,
+        *          which are replaced when the cluster is remapped
+        */
+        std::shared_mutex _topology_mutex;
+
+        /*!
+        *   \brief Whether a background remap of the cluster is running
+        */
+        std::atomic<bool> _refresh_pending{false};
+
+        /*!
+        *   \brief The background remap of the cluster
+        */
+        std::future<void> _refresh_future;
+
+        /*!
+        *   \brief Guards _refresh_future
+        */
+        std::mutex _refresh_mutex;
+
+        /*!
+        *   \brief The connection to each DBNode, in the same order
+        *          as _db_nodes
+        */
+        std::vector<sw::redis::Redis*> _db_connections;
+
+        /*!
+        *   \brief Connections to the db nodes, indexed by "address:port".
+        *          Connections are kept for the life of the RedisCluster
+        *          so that they can be reused when the cluster is remapped.
+        */
+        std::unordered_map<std::string, std::unique_ptr<sw::redis::Redis>>
+            _node_connections;
+
+        /*!
+        *   \brief Guards _node_connections
+        */
+        std::mutex _node_connections_mutex;
+
+        /*!
+        *   \brief The number of hash slots in a cluster
+        */
+        static constexpr size_t _N_HASH_SLOTS = 16384;
+
+        /*!
+        *   \brief Marks a hash slot that no DBNode serves
+        */
+        static constexpr uint16_t _NO_DB_NODE = UINT16_MAX;
+
+        /*!
+        *   \brief The number of connections that are opened to
+        *          each db node
+        */
+        int _connections_per_node;
+
+        /*!
+        *   \brief Path of the Unix domain socket of the co-located
+        *          db node, or empty if it is reached over TCP
         */
-        std::string _last_prefix;
+        std::string _local_socket;
+
+        /*!
+        *   \brief The cluster address, in the form address:port, of
+        *          the db node that is reached through _local_socket
+        */
+        std::string _local_address;
+
+        /*!
+        *   \brief Default number of connections to each db node
+        */
+        static constexpr int _DEFAULT_CONNS_PER_NODE = 1;
+
+        /*!
+        *   \brief Environment variable for the number of connections
+        *          to each db node
+        */
+        inline static const std::string _CONNS_PER_NODE_ENV_VAR =
+            "SR_CONNS_PER_NODE";
+
+        /*!
+        *   \brief A hash slot of the most recently used DBNode.
+        *          This is shared between the caller and the Client
+        *          asynchronous request thread.
+        */
+        std::atomic<uint16_t> _last_hash_slot{0};
+
+        /*!
+        *   \brief Initialize the number of connections to each
+        *          db node from the environment
+        *   \throw ParameterException if the number of connections
+        *          is not greater than 0
+        */
+        void _init_connections_per_node();
 
         /*!
         *   \brief Run the command on the correct db node
+        *   \details A MOVED redirect updates the hash slot map and
+        *            the command is retried on the new db node right
+        *            away.  An ASK redirect sends the command once to
+        *            the db node that is importing the hash slot.
         *   \param cmd The command to run on the server
-        *   \param db_prefix The prefix of the db node the
+        *   \param hash_slot A hash slot of the db node the
         *                    command addresses
         *   \returns The CommandReply from the
         *            command execution
         */
-        inline CommandReply _run(const Command& cmd, std::string db_prefix);
+        inline CommandReply _run(const Command& cmd, uint16_t hash_slot);
+
+        /*!
+        *   \brief Pipeline a group of Command to the db node that
+        *          serves a hash slot
+        *   \details An IO error remaps the cluster before the group
+        *            is retried on the db node that serves the hash
+        *            slot.  Command that receive a MOVED or ASK reply
+        *            are run again on their own with _run(), after a
+        *            MOVED reply has updated the hash slot map.
+        *   \param cmds The Command to run, in order
+        *   \param hash_slot A hash slot of the db node the
+        *                    Command address
+        *   \param sink If not NULL, the TensorBlobSink attached while
+        *               the replies of the group are read.  Command
+        *               that are run again leave the sink unfilled.
+        *   \returns A CommandReply for each Command in cmds
+        */
+        std::vector<CommandReply> _run_group(std::vector<Command*>& cmds,
+                                             uint16_t hash_slot,
+                                             TensorBlobSink* sink = NULL);
+
+        /*!
+        *   \brief Check the replies of a pipelined group of Command
+        *          and run the Command that were redirected again
+        *   \details Command that receive a MOVED or ASK reply are run
+        *            again on their own with _run(), after a MOVED
+        *            reply has updated the hash slot map.  Their
+        *            replies are replaced in place.
+        *   \param replies The replies of the group, in order
+        *   \param cmds The Command of the group, in order
+        *   \throw RuntimeException if any Command failed with an
+        *          error other than a redirect
+        */
+        void _follow_redirects(std::vector<CommandReply>& replies,
+                               std::vector<Command*>& cmds);
+
+        /*!
+        *   \brief Run Command as one MULTI/EXEC transaction on the
+        *          db node that serves a hash slot
+        *   \details If any Command receives a MOVED or ASK reply
+        *            because the hash slot is being moved, the
+        *            transaction is aborted and sent again as a
+        *            whole, after a MOVED reply has updated the hash
+        *            slot map.
+        *   \param cmds The Command to run in the transaction, in order
+        *   \param hash_slot A hash slot of the db node the
+        *                    Command address
+        *   \returns The reply to EXEC, which holds the reply to each
+        *            Command in cmds
+        *   \throw SmartRedis::Exception if the transaction fails or
+        *          is still redirected after every attempt
+        */
+        CommandReply _run_transaction(std::vector<Command*>& cmds,
+                                      uint16_t hash_slot);
+
+        /*!
+        *   \brief Send a group of Command to the db node that serves
+        *          a hash slot and collect the replies without any
+        *          checking of the replies
+        *   \details An IO error remaps the cluster before the group
+        *            is retried on the db node that serves the hash
+        *            slot.  MOVED and ASK replies are returned rather
+        *            than thrown.
+        *   \param cmds The Command to run, in order
+        *   \param hash_slot A hash slot of the db node the
+        *                    Command address
+        *   \param sink If not NULL, the TensorBlobSink attached while
+        *               the replies of the group are read
+        *   \returns A CommandReply for each Command in cmds
+        */
+        std::vector<CommandReply> _exec_group(std::vector<Command*>& cmds,
+                                              uint16_t hash_slot,
+                                              TensorBlobSink* sink = NULL);
+
+        /*!
+        *   \brief Update the hash slot map from a MOVED reply
+        *   \param reply The reply, which is ignored unless it is a
+        *                MOVED error
+        */
+        void _note_moved_reply(CommandReply& reply);
 
         /*!
         *   \brief Connect to the cluster at the address and port
@@ -397,25 +679,128 @@ class RedisCluster : public RedisServer
         */
         inline void _connect(std::string address_port);
 
+        /*!
+        *   \brief Connect to a co-located db node through its
+        *          Unix domain socket
+        *   \details redis++ only seeds a cluster over TCP, so the
+        *            db node is asked for its cluster address with
+        *            CLUSTER NODES.  The socket connection then serves
+        *            every Command routed to that db node, and the
+        *            cluster address seeds the cluster connection.
+        *   \param address_port The SSDB entry of the db node
+        *   \returns The TCP address to seed the cluster connection
+        *             with, which is address_port itself unless it
+        *             has the form unix://path
+        */
+        std::string _connect_local_socket(const std::string& address_port);
+
+        /*!
+        *   \brief Get the cluster address of a db node
+        *   \param host The host, or socket path, of the db node
+        *   \param port The port of the db node, 0 for a socket path
+        *   \returns The address of the db node in the form
+        *             address:port
+        */
+        std::string _get_node_address(const std::string& host,
+                                      uint64_t port);
+
         /*!
         *   \brief Map the RedisCluster via the CLUSTER SLOTS
         *          command.
+        *   \details The new map is built before it replaces the
+        *            current one, so Command that are routed while
+        *            the cluster is being remapped are not held up.
         */
         inline void _map_cluster();
 
         /*!
-        *   \brief Get the prefix that can be used to address
-        *          the correct database for a given command
-        *   \param cmd The Command to analyze for DBNode prefix
+        *   \brief Record that a hash slot has moved to another
+        *          db node and remap the rest of the cluster
+        *          in the background
+        *   \param hash_slot The hash slot that has moved
+        *   \param node The db node that now serves the hash slot
+        */
+        void _note_moved_slot(size_t hash_slot, const sw::redis::Node& node);
+
+        /*!
+        *   \brief Get all of the DBNodes in the cluster
+        *   \returns A copy of the DBNodes, ordered by hash slot
+        */
+        std::vector<DBNode> _get_db_nodes();
+
+        /*!
+        *   \brief Get the prefix of the DBNode at an address
+        *   \param address The address of the DBNode as address:port
         *   \returns The DBNode prefix as a string
+        *   \throw RuntimeException if no DBNode is at the address
+        */
+        std::string _get_address_prefix(const std::string& address);
+
+        /*!
+        *   \brief Get a hash slot of the DBNode at an address
+        *   \param address The address of the DBNode as address:port
+        *   \returns The lowest hash slot of the DBNode
+        *   \throw RuntimeException if no DBNode is at the address
+        */
+        uint16_t _get_address_hash_slot(const std::string& address);
+
+        /*!
+        *   \brief Get the connection to the db node that serves
+        *          a hash slot
+        *   \param hash_slot The hash slot
+        *   \returns The connection to the db node
+        *   \throw RuntimeException if no DBNode serves the hash slot
+        */
+        sw::redis::Redis* _get_slot_connection(uint16_t hash_slot);
+
+        /*!
+        *   \brief Get the connection to the db node at an address,
+        *          opening it on first use
+        *   \param host The host of the db node
+        *   \param port The port of the db node
+        *   \returns The connection to the db node
+        */
+        sw::redis::Redis* _get_address_connection(const std::string& host,
+                                                  uint64_t port);
+
+        /*!
+        *   \brief Get the hash slot that can be used to address
+        *          the correct database for a given command
+        *   \param cmd The Command to analyze for the hash slot
+        *   \returns The hash slot of the first key of the Command
         *   \throw RuntimeException if the Command does not have
-        *          keys or if multiple keys have different prefixes
+        *          keys or if the keys are on different DBNodes
+        */
+        uint16_t _get_keys_hash_slot(Command& cmd);
+
+        /*!
+        *   \brief Get a hash slot of the db node that a Command
+        *          of any type in a CommandList addresses
+        *   \param cmd The Command to analyze for the hash slot
+        *   \returns The hash slot as an integer
+        *   \throw RuntimeException if the db node for the Command
+        *          cannot be determined
+        */
+        uint16_t _get_cmd_hash_slot(Command* cmd);
+
+        /*!
+        *   \brief Copy a tensor by retrieving it from the source key
+        *          and putting it back under the destination key.
+        *          This is used when the keys are in different
+        *          hash slots.
+        *   \param src_key The source key for the tensor copy
+        *   \param dest_key The destination key for the tensor copy
+        *   \returns The CommandReply from the put command
+        *   \throw RuntimeException if the source tensor cannot
+        *          be retrieved
         */
-        std::string _get_db_node_prefix(Command& cmd);
+        CommandReply _client_side_copy(const std::string& src_key,
+                                       const std::string& dest_key);
 
         /*!
         *   \brief Processes the CommandReply for CLUSTER SLOTS
-        *          to build DBNode information
+        *          to build DBNode information, then replaces
+        *          the current DBNode information with it
         *   \param reply The CommandReply for CLUSTER SLOTS
         *   \throw RuntimeException if there is an error
         *          creating a prefix for a particular DBNode
@@ -484,61 +869,118 @@ class RedisCluster : public RedisServer
 
         /*!
         *   \brief  Get the index of the DBNode responsible
-        *           for the hash slot
+        *           for the hash slot.  _topology_mutex must be
+        *           held by the caller.
         *   \param hash_slot The hash slot to search for
-        *   \param lhs The lower bound of the DBNode array to
-        *              search (inclusive)
-        *   \param rhs The upper bound of the DBNode array to
-        *              search (inclusive)
         *   \returns DBNode index responsible for the hash slot
-        */
-        uint16_t _get_dbnode_index(uint16_t hash_slot,
-                                   unsigned lhs,
-                                   unsigned rhs);
-
-        /*!
-        *   \brief  Attaches a prefix and constant suffix to keys to
-        *           enforce identical hash slot constraint
-        *   \param names The keys that need to be updated for identical
-        *                hash slot constraint
-        *   \param db_prefix The prefix to attach
-        *   \returns A vector of updated names
-        */
-        std::vector<std::string>  _get_tmp_names(std::vector<std::string> names,
-                                                 std::string db_prefix);
-
-        /*!
-        *   \brief  Delete multiple keys with the assumption that all
-        *           keys use the same hash slot
-        *   \param keys The keys to be deleted
-        *   \returns A vector of updated names
-        */
-        void _delete_keys(std::vector<std::string> keys);
-
-        /*!
-        *   \brief  Run a model in the database that uses dagrun
-        *   \param key The key associated with the model
-        *   \param inputs The keys of inputs tensors to use
-        *                 in the model
-        *   \param outputs The keys of output tensors that
-        *                 will be used to save model results
-        */
-        void __run_model_dagrun(const std::string& key,
-                                std::vector<std::string> inputs,
-                                std::vector<std::string> outputs);
-
-        /*!
-        *   \brief  Retrieve the optimum model prefix for
-        *           the set of inputs
-        *   \param name The name of the model
-        *   \param inputs The keys of inputs tensors to use
-        *                 in the model
-        *   \param outputs The keys of output tensors that
-        *                 will be used to save model results
-        */
-        DBNode* _get_model_script_db(const std::string& name,
-                                     std::vector<std::string>& inputs,
-                                     std::vector<std::string>& outputs);
+        *   \throw RuntimeException if no DBNode serves the hash slot
+        */
+        uint16_t _get_dbnode_index(uint16_t hash_slot);
+
+        /*!
+        *   \brief  Get the db node whose copy of a model or script
+        *           needs the fewest tensors to be moved for a run
+        *   \param inputs The keys of inputs tensors of the run
+        *   \param outputs The keys of output tensors of the run
+        *   \returns A copy of the DBNode to run on
+        */
+        DBNode _get_model_script_node(const std::vector<std::string>& inputs,
+                                      const std::vector<std::string>& outputs);
+
+        /*!
+        *   \brief  Get the keys that tensors are run under on a
+        *           db node.  Keys that are in the hash slot of the
+        *           db node prefix are kept, and the rest are given
+        *           a temporary key in that hash slot.
+        *   \param names The keys of the tensors
+        *   \param db The db node of the run
+        *   \returns A vector of keys to run with
+        */
+        std::vector<std::string> _get_run_names(
+            const std::vector<std::string>& names, const DBNode& db);
+
+        /*!
+        *   \brief Build a Command that restores a value serialized
+        *          by DUMP under a key, replacing any existing value
+        *   \param cmd The SingleKeyCommand to fill
+        *   \param key The key to restore the value under
+        *   \param dump The reply to DUMP.  It must outlive
+        *               the Command.
+        */
+        inline void _build_restore(SingleKeyCommand& cmd,
+                                   const std::string& key,
+                                   CommandReply& dump);
+
+        /*!
+        *   \brief  Run a model or script with the tensors that are
+        *           outside of its hash slot moved in and out around
+        *           the run
+        *   \details The inputs to move are fetched with DUMP from
+        *            all of their db nodes at once.  They are then
+        *            restored, the model or script is run, the outputs
+        *            to move are fetched and the temporary keys are
+        *            deleted in a single pipeline to the run db node.
+        *            Finally, the outputs are restored under their own
+        *            keys.  Tensors that are already in the hash slot
+        *            of the run are not moved.
+        *   \param run_cmd The Command that runs the model or script
+        *   \param inputs The keys of the input tensors
+        *   \param run_inputs The keys of the input tensors in run_cmd
+        *   \param outputs The keys of the output tensors
+        *   \param run_outputs The keys of the output tensors in run_cmd
+        *   \returns The CommandReply of run_cmd
+        *   \throw RuntimeException if an input or output tensor
+        *          cannot be found or a Command fails
+        */
+        CommandReply _run_with_transfers(
+            const CompoundCommand& run_cmd,
+            const std::vector<std::string>& inputs,
+            const std::vector<std::string>& run_inputs,
+            const std::vector<std::string>& outputs,
+            const std::vector<std::string>& run_outputs);
+
+        /*!
+        *   \brief  Set a model or script on every db node
+        *   \details Db nodes that already hold a copy with the
+        *            same digest are skipped.  The other db nodes are
+        *            set concurrently, with at most
+        *            _MAX_PARALLEL_UPLOADS at a time, and the digest
+        *            of each new copy is stored next to it in the
+        *            same transaction.  Copies written without
+        *            SmartRedis do not update the digest, so they
+        *            are not detected.
+        *   \param name The key of the model or script, without the
+        *               db node prefix
+        *   \param db_nodes The db nodes to set the model or script on
+        *   \param cmds The Command that set the model or script,
+        *               one for each db node
+        *   \returns The reply to the set on the last db node, or
+        *            an OK status reply if that db node was skipped
+        *   \throw RuntimeException naming every db node that failed
+        */
+        CommandReply _set_on_all_nodes(const std::string& name,
+                                       const std::vector<DBNode>& db_nodes,
+                                       std::vector<CompoundCommand>& cmds);
+
+        /*!
+        *   \brief  Get a digest of a model or script set Command
+        *           from all of its fields except the key
+        *   \param cmd The Command that sets the model or script
+        *   \returns The digest as a hexadecimal string
+        */
+        static std::string _get_replica_digest(const Command& cmd);
+
+        /*!
+        *   \brief The most db nodes that a model or script is
+        *          uploaded to at a time
+        */
+        static constexpr size_t _MAX_PARALLEL_UPLOADS = 8;
+
+        /*!
+        *   \brief Suffix of the key that holds the digest of the
+        *          model or script at the key without it
+        */
+        inline static const std::string _DIGEST_SUFFIX = ".sr_digest";
 };
 
 } //namespace SmartRedis
@@ -30,6 +30,8 @@
 #define SMARTREDIS_CPP_REDISSERVER_H
 
 #include <thread>
+#include <mutex>
+#include <unordered_map>
 #include <iostream>
 #include "limits.h"
 
@@ -50,6 +52,8 @@
 #include "clusterinfocommand.h"
 #include "dbinfocommand.h"
 #include "gettensorcommand.h"
+#include "tensorblobsink.h"
+#include "rawconnectionpool.h"
 
 ///@file
 
@@ -84,6 +88,20 @@ class RedisServer {
         */
         virtual CommandReply run(SingleKeyCommand& cmd) = 0;
 
+        /*!
+        *   \brief Run a single-key Command whose key is in a
+        *          known hash slot
+        *   \details The hash slot is obtained once with
+        *            get_hash_slot() so that the key does not
+        *            need to be hashed on every execution.
+        *   \param cmd The single-key Comand to run
+        *   \param hash_slot The hash slot of the Command key
+        *   \returns The CommandReply from the
+        *            command execution
+        */
+        virtual CommandReply run(SingleKeyCommand& cmd,
+                                 uint16_t hash_slot) = 0;
+
         /*!
         *   \brief Run a multi-key Command on the server
         *   \param cmd The multi-key Comand to run
@@ -122,8 +140,9 @@ class RedisServer {
 
         /*!
         *   \brief Run multiple single-key or single-hash slot
-        *          Command on the server.  Each Command in the
-        *          CommandList is run sequentially.
+        *          Command on the server.  The Command in the
+        *          CommandList are pipelined to the server and
+        *          the replies are returned in CommandList order.
         *   \param cmd The CommandList containing multiple
         *              single-key or single-hash
         *              slot Comand to run
@@ -163,6 +182,39 @@ class RedisServer {
          */
         virtual bool is_addressable(const std::string& address, const uint64_t& port) = 0;
 
+        /*!
+         *  \brief Check if two keys can be addressed by a single
+         *         multi-key command, such as RENAME
+         *  \param key The first key
+         *  \param other_key The second key
+         *  \return True if the keys are co-located
+         */
+        virtual bool is_colocated(const std::string& key,
+                                  const std::string& other_key) = 0;
+
+        /*!
+         *  \brief Get the hash slot of a key
+         *  \param key The key
+         *  \return The hash slot of the key
+         */
+        virtual uint16_t get_hash_slot(const std::string& key) = 0;
+
+        /*!
+        *   \brief Get the address of the database node that
+        *          holds a key
+        *   \param key The key
+        *   \returns The address of the database node (host:port)
+        */
+        virtual std::string get_key_address(const std::string& key) = 0;
+
+        /*!
+        *   \brief Get the key that get_model() and get_script()
+        *          read a model or script from
+        *   \param key The key associated with the model or script
+        *   \returns The key read on the database
+        */
+        virtual std::string get_model_script_key(const std::string& key) = 0;
+
         /*!
         *   \brief Put a Tensor on the server
         *   \param tensor The Tensor to put on the server
@@ -179,6 +231,36 @@ class RedisServer {
         */
         virtual CommandReply get_tensor(const std::string& key) = 0;
 
+        /*!
+        *   \brief Get a Tensor from the server, writing its data
+        *          into the memory space of a TensorBlobSink while
+        *          the reply is read
+        *   \details If the tensor does not match the memory space
+        *            of the sink, the sink is left unfilled and the
+        *            reply holds the tensor data as usual.
+        *   \param key The name of the tensor to retrieve
+        *   \param sink The destination of the tensor data
+        *   \returns The CommandReply from the get tensor server
+        *            command execution
+        */
+        virtual CommandReply get_tensor(const std::string& key,
+                                        TensorBlobSink& sink) = 0;
+
+        /*!
+        *   \brief Get a Tensor from the server, writing its data
+        *          into the memory space of a TensorBlobSink while
+        *          the reply is read
+        *   \param key The name of the tensor to retrieve
+        *   \param sink The destination of the tensor data
+        *   \param hash_slot The hash slot of the key, as returned
+        *                    by get_hash_slot()
+        *   \returns The CommandReply from the get tensor server
+        *            command execution
+        */
+        virtual CommandReply get_tensor(const std::string& key,
+                                        TensorBlobSink& sink,
+                                        uint16_t hash_slot) = 0;
+
         /*!
         *   \brief Rename a tensor in the database
         *   \param key The original key for the tensor
@@ -418,13 +500,55 @@ class RedisServer {
         inline static const std::string _CMD_INTERVAL_ENV_VAR =
             "SR_CMD_INTERVAL";
 
+        /*!
+        *   \brief URI scheme of SSDB entries that name a
+        *          Unix domain socket
+        */
+        inline static const std::string _UNIX_SCHEME = "unix://";
+
+        /*!
+        *   \brief Lua script that copies the value at KEYS[1] to
+        *          KEYS[2] without the value leaving the server.
+        *          DUMP/RESTORE is used instead of COPY because it
+        *          is available before Redis 6.2 and supports module
+        *          types, such as RedisAI tensors, that do not
+        *          implement the COPY callback.
+        */
+        inline static const std::string _SERVER_COPY_SCRIPT =
+            "local v = redis.call('DUMP', KEYS[1]) "
+            "if not v then "
+            "return redis.error_reply('ERR no such key ' .. KEYS[1]) "
+            "end "
+            "return redis.call('RESTORE', KEYS[2], 0, v, 'REPLACE')";
+
+        /*!
+        *   \brief Build a Command that runs _SERVER_COPY_SCRIPT to
+        *          copy the value at a key to another key.  Both
+        *          keys must be served by the same db node.
+        *   \param cmd The CompoundCommand to fill
+        *   \param src_key The source key of the copy
+        *   \param dest_key The destination key of the copy
+        */
+        void _build_server_copy(CompoundCommand& cmd,
+                                const std::string& src_key,
+                                const std::string& dest_key);
+
+        /*!
+        *   \brief Size in bytes at or above which a Command field is
+        *          written to the socket from its own memory rather
+        *          than being formatted into the hiredis output buffer
+        */
+        static constexpr size_t _VECTORED_SEND_THRESHOLD = 1 << 20;
+
         /*!
         *   \brief Retrieve a single address, randomly
         *          chosen from a list of addresses if
         *          applicable, from the SSDB environment
         *          variable.
-        *   \returns A address and port pair in the form of
-        *            address:port
+        *   \details Entries of the form unix://path name a
+        *            Unix domain socket and are returned as is.
+        *   \returns A URI in the form of tcp://address:port
+        *            or unix://path
         */
         std::string _get_ssdb();
 
@@ -433,6 +557,16 @@ class RedisServer {
         */
         std::unordered_map<std::string, DBNode*> _address_node_map;
 
+        /*!
+        *   \brief Record the address on which raw hiredis connections
+        *          to a database node are opened
+        *   \param db The redis++ connection to the database node
+        *   \param address The address of the database node, either
+        *                  host:port or the path of a Unix domain socket
+        */
+        void _set_raw_address(const sw::redis::Redis* db,
+                              const std::string& address);
+
         /*!
         *   \brief Check that the SSDB environment variable
         *          value does not have any errors
@@ -469,7 +603,219 @@ class RedisServer {
         */
         void _check_runtime_variables();
 
+        /*!
+        *   \brief Execute a group of Command on a single database
+        *          node as one pipeline.
+        *   \details All of the Command are written to the connection
+        *            back-to-back before any reply is read, so the
+        *            group costs a single network round trip.  The
+        *            replies are returned in the order of the Command.
+        *            The whole pipeline is retried on connection
+        *            errors in the same manner as single Command
+        *            execution.
+        *   \param db The database node that will execute the Command
+        *   \param cmds The Command to execute, in order
+        *   \param sink If not NULL, the TensorBlobSink attached while
+        *               the replies are read
+        *   \returns A CommandReply for each Command in cmds
+        *   \throw SmartRedis::Exception if any Command in the
+        *          pipeline fails or the pipeline cannot be executed
+        */
+        std::vector<CommandReply> _run_pipeline(sw::redis::Redis& db,
+                                                std::vector<Command*>& cmds,
+                                                TensorBlobSink* sink = NULL);
+
+        /*!
+        *   \brief Execute a single Command on a database node
+        *          without any retry or error checking of the reply.
+        *   \details Command with a field of at least
+        *            _VECTORED_SEND_THRESHOLD bytes are written with
+        *            _send_vectored() on a raw hiredis connection so
+        *            that the field is not copied into a protocol
+        *            buffer.  All other Command are sent through
+        *            redis++ as usual.
+        *   \param db The database node that will execute the Command
+        *   \param cmd The Command to execute
+        *   \returns The CommandReply from the Command
+        */
+        CommandReply _exec_command(sw::redis::Redis& db, const Command& cmd);
+
+        /*!
+        *   \brief Get a Tensor from a database node, writing its data
+        *          into the memory space of a TensorBlobSink
+        *   \details The tensor is read on a raw hiredis connection
+        *            so that the sink can be attached to its reader.
+        *   \param db The database node that holds the tensor
+        *   \param key The name of the tensor to retrieve
+        *   \param sink The destination of the tensor data
+        *   \returns The CommandReply from the get tensor command
+        */
+        CommandReply _get_tensor_to_sink(sw::redis::Redis& db,
+                                         const std::string& key,
+                                         TensorBlobSink& sink);
+
+        /*!
+        *   \brief Send a group of Command to a database node and
+        *          collect the replies without any retry or error
+        *          checking of the replies.
+        *   \details A group that has a TensorBlobSink or a Command
+        *            to be written with _send_vectored() is run on a
+        *            raw hiredis connection, and all others through
+        *            redis++.  In both cases an error reply to the
+        *            final Command is thrown, as redis++ does.
+        *   \param db The database node that will execute the Command
+        *   \param cmds The Command to execute, in order
+        *   \param sink If not NULL, the TensorBlobSink attached while
+        *               the replies are read
+        *   \returns A CommandReply for each Command in cmds
+        */
+        std::vector<CommandReply>
+        _exec_pipeline(sw::redis::Redis& db, std::vector<Command*>& cmds,
+                       TensorBlobSink* sink);
+
+        /*!
+        *   \brief Write a group of Command to a database node on a
+        *          raw hiredis connection without reading the replies
+        *   \details Writing the pipelines of several database nodes
+        *            before reading any reply lets the nodes work on
+        *            them at the same time.  The replies must then be
+        *            read with _recv_pipeline().
+        *   \param db The database node that will execute the Command
+        *   \param cmds The Command to execute, in order
+        *   \returns The connection the Command were written to
+        *   \throw sw::redis::Error if the Command cannot be sent
+        */
+        redisContext* _send_pipeline(sw::redis::Redis& db,
+                                     std::vector<Command*>& cmds);
+
+        /*!
+        *   \brief Read the replies to a group of Command written
+        *          with _send_pipeline() without any error checking
+        *          of the replies
+        *   \details The connection is returned for reuse once every
+        *            reply is read, and is closed otherwise.
+        *   \param db The database node that executes the Command
+        *   \param context The connection returned by _send_pipeline()
+        *   \param n_replies The number of Command that were written
+        *   \returns A CommandReply for each Command, in order
+        *   \throw sw::redis::Error if a reply cannot be read
+        */
+        std::vector<CommandReply> _recv_pipeline(sw::redis::Redis& db,
+                                                 redisContext* context,
+                                                 size_t n_replies);
 
+        /*!
+        *   \brief Throw on the first error reply of a pipeline
+        *   \param replies The replies of the pipeline
+        *   \param cmds The Command of the pipeline, in order
+        *   \param skip_redirects If set, MOVED and ASK replies are
+        *                         not treated as errors
+        *   \throw RuntimeException naming the first Command that
+        *          failed, its key and the server error
+        */
+        void _check_pipeline_replies(std::vector<CommandReply>& replies,
+                                     std::vector<Command*>& cmds,
+                                     bool skip_redirects = false);
+
+        /*!
+        *   \brief Check whether a reply is a MOVED or ASK redirect
+        *   \param reply The reply to check
+        *   \returns True if the reply is a MOVED or ASK error
+        */
+        static bool _is_redirect(CommandReply& reply);
+
+    private:
+
+        /*!
+        *   \brief The hiredis connections used for the requests that
+        *          work on the hiredis context itself
+        */
+        RawConnectionPool _raw_connections;
+
+        /*!
+        *   \brief The address on which raw hiredis connections are
+        *          opened, indexed by the redis++ connection to the
+        *          same database node
+        */
+        std::unordered_map<const sw::redis::Redis*, std::string>
+            _raw_addresses;
+
+        /*!
+        *   \brief Guards _raw_addresses
+        */
+        std::mutex _raw_addresses_mutex;
+
+        /*!
+        *   \brief Get the address on which raw hiredis connections
+        *          to a database node are opened
+        *   \param db The redis++ connection to the database node
+        *   \returns The address recorded with _set_raw_address()
+        *   \throw InternalException if no address was recorded
+        */
+        std::string _get_raw_address(const sw::redis::Redis* db);
+
+        /*!
+        *   \brief Send a group of Command on a raw hiredis connection
+        *          and collect the replies
+        *   \details The Command are written back-to-back and then
+        *            every reply is read.  If anything fails, the
+        *            connection is closed rather than reused, since it
+        *            may hold a partial Command or unread replies.
+        *   \param address The address of the database node
+        *   \param cmds The Command to execute, in order
+        *   \param sink If not NULL, the TensorBlobSink attached while
+        *               the replies are read
+        *   \returns A CommandReply for each Command in cmds
+        *   \throw sw::redis::Error if the Command cannot be sent, a
+        *          reply cannot be read, or the final reply is an error
+        */
+        std::vector<CommandReply>
+        _exec_raw_pipeline(const std::string& address,
+                           std::vector<Command*>& cmds,
+                           TensorBlobSink* sink);
+
+        /*!
+        *   \brief Write a group of Command to a raw hiredis
+        *          connection and flush them to the socket
+        *   \param context The connection to write to
+        *   \param cmds The Command to write, in order
+        *   \throw sw::redis::Error if a Command cannot be sent
+        */
+        static void _send_raw_commands(redisContext* context,
+                                       std::vector<Command*>& cmds);
+
+        /*!
+        *   \brief Read a single reply from a raw hiredis connection
+        *   \param context The connection to read from
+        *   \returns The reply
+        *   \throw sw::redis::Error if the reply cannot be read
+        */
+        static RedisReplyUPtr _read_raw_reply(redisContext* context);
+
+        /*!
+        *   \brief Check whether a Command has a field large enough
+        *          to be sent with _send_vectored()
+        *   \param cmd The Command to check
+        *   \returns True if the Command should be sent with
+        *            _send_vectored()
+        */
+        static bool _use_vectored_send(const Command& cmd);
+
+        /*!
+        *   \brief Write a Command to a connection with vectored I/O
+        *   \details Any output already buffered by hiredis is flushed
+        *            first so that the order of pipelined Command is
+        *            preserved.  The RESP headers and the small fields
+        *            are formatted into a local buffer, and each large
+        *            field is passed to writev() straight from the
+        *            memory that the Command references.  On a write
+        *            failure the context is marked as broken so that
+        *            the connection is not reused.
+        *   \param context The hiredis context of the connection
+        *   \param cmd The Command to write
+        *   \throw sw::redis::IoError if the Command cannot be written
+        */
+        static void _send_vectored(redisContext* context, const Command& cmd);
 };
 
 } // namespace SmartRedis
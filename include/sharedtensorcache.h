@@ -0,0 +1,298 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_SHAREDTENSORCACHE_H
+#define SMARTREDIS_SHAREDTENSORCACHE_H
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include "redisserver.h"
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+class SharedTensorCache;
+
+/*!
+*   \brief The SharedTensorCache class shares the tensors read by the
+*          processes of a compute node through POSIX shared memory.
+*   \details Each tensor is held in a shared memory segment named
+*            after a hash of the run ID and address of the database
+*            node and the key, so the segment names form an index
+*            that every process on the compute node can look up
+*            without taking a lock.
+*            The first process to read a tensor creates the segment
+*            exclusively, fetches the tensor from the database and
+*            publishes it by setting the segment state with an
+*            atomic store.  Other processes open the existing segment,
+*            wait for it to be published and map the tensor data
+*            read-only.  Segments are removed by the last process to
+*            detach from them, or when the tensor is written through
+*            a client that uses the cache.  Writes made by clients
+*            that do not use the cache are not seen, so the cache is
+*            meant for tensors that do not change once they are read,
+*            such as broadcast fields and model weights.
+*
+*            A process that stops without destroying its cache leaves
+*            its segments behind.  The run ID of a restarted database
+*            differs, so they are never read by a later job, and they
+*            can be removed with rm /dev/shm/sr.<uid>.* once no
+*            process of the user on the compute node uses the cache.
+*/
+class SharedTensorCache
+{
+    public:
+
+        /*!
+        *   \brief SharedTensorCache constructor
+        */
+        SharedTensorCache();
+
+        /*!
+        *   \brief SharedTensorCache copy constructor is not allowed
+        *   \param cache The SharedTensorCache to copy for construction
+        */
+        SharedTensorCache(const SharedTensorCache& cache) = delete;
+
+        /*!
+        *   \brief SharedTensorCache copy assignment is not allowed
+        *   \param cache The SharedTensorCache to copy for assignment
+        */
+        SharedTensorCache& operator=(const SharedTensorCache& cache) = delete;
+
+        /*!
+        *   \brief SharedTensorCache destructor.  Detaches from every
+        *          segment that was mapped, which invalidates the
+        *          data returned by get().
+        */
+        ~SharedTensorCache();
+
+        /*!
+        *   \brief Get a read-only view of a tensor, fetching it
+        *          from the database if no process on the compute
+        *          node has done so yet
+        *   \details If hand_out is set, the data remain valid until
+        *            the SharedTensorCache is destroyed.  Otherwise
+        *            they are meant to be copied right away, and the
+        *            mapping is released as soon as the tensor is
+        *            written and read again, so that the shared
+        *            memory of the old tensor is returned.
+        *   \param server The server the tensor is fetched from
+        *   \param key The key of the tensor
+        *   \param blob Receives the contiguous tensor data
+        *   \param dims Receives the dimensions of the tensor
+        *   \param type Receives the type of the tensor
+        *   \param hand_out Set if the data are handed out to the
+        *                   user rather than copied
+        *   \returns True if the tensor was read through shared
+        *            memory.  False if the shared memory could not
+        *            be used or the tensor could not be fetched, in
+        *            which case the caller should read it as usual.
+        */
+        bool get(RedisServer& server,
+                 const std::string& key,
+                 std::string_view& blob,
+                 std::vector<size_t>& dims,
+                 SRTensorType& type,
+                 bool hand_out = false);
+
+        /*!
+        *   \brief Remove the segment of a tensor after it was
+        *          written, so that it is fetched again on the
+        *          next read by any process on the compute node
+        *   \param server The server that holds the tensor
+        *   \param key The key of the tensor
+        */
+        void invalidate(RedisServer& server, const std::string& key);
+
+        /*!
+        *   \brief Remove the segments of every tensor mapped by
+        *          this process
+        */
+        void invalidate_all();
+
+    private:
+
+        /*!
+        *   \brief A segment mapped by this process
+        */
+        struct Mapping
+        {
+            /*!
+            *   \brief The name of the segment
+            */
+            std::string name;
+
+            /*!
+            *   \brief The start of the mapping
+            */
+            void* addr;
+
+            /*!
+            *   \brief The length of the mapping
+            */
+            size_t length;
+
+            /*!
+            *   \brief Set once the data of the mapping were handed
+            *          out, after which it stays mapped until the
+            *          SharedTensorCache is destroyed
+            */
+            bool handed_out;
+        };
+
+        /*!
+        *   \brief Create a segment exclusively and fill it with
+        *          a tensor fetched from the database
+        *   \param fd The file descriptor of the created segment
+        *   \param name The name of the segment
+        *   \param id The identity of the tensor from _segment_id()
+        *   \param server The server the tensor is fetched from
+        *   \param key The key of the tensor
+        *   \returns True if the segment was filled and mapped
+        */
+        bool _fill(int fd, const std::string& name, const std::string& id,
+                   RedisServer& server, const std::string& key);
+
+        /*!
+        *   \brief Give up on filling a created segment.  Processes
+        *          waiting for it are told to stop waiting and the
+        *          segment is removed.
+        *   \param fd The file descriptor of the created segment
+        *   \param name The name of the segment
+        */
+        void _abandon(int fd, const std::string& name);
+
+        /*!
+        *   \brief Map a segment created by another process once
+        *          it has been filled
+        *   \param fd The file descriptor of the segment
+        *   \param name The name of the segment
+        *   \param id The identity of the tensor from _segment_id()
+        *   \returns True if the segment was filled and mapped
+        */
+        bool _attach(int fd, const std::string& name, const std::string& id);
+
+        /*!
+        *   \brief Detach from a segment and unmap it.  The last
+        *          process to detach removes the segment.
+        *   \param mapping The mapping of the segment
+        */
+        static void _detach(Mapping& mapping);
+
+        /*!
+        *   \brief Release a mapping whose segment was retired.
+        *          Mappings whose data were handed out are kept
+        *          until the SharedTensorCache is destroyed, and
+        *          the others are detached right away.
+        *   \param mapping The mapping of the segment
+        */
+        void _release(Mapping& mapping);
+
+        /*!
+        *   \brief Read the tensor held by a mapped segment
+        *   \param mapping The mapping of the segment
+        *   \param blob Receives the contiguous tensor data
+        *   \param dims Receives the dimensions of the tensor
+        *   \param type Receives the type of the tensor
+        */
+        static void _read(const Mapping& mapping,
+                          std::string_view& blob,
+                          std::vector<size_t>& dims,
+                          SRTensorType& type);
+
+        /*!
+        *   \brief Get the identity of a tensor, which is made of the
+        *          run ID and address of the database node and the key
+        *   \details The run ID changes each time the database is
+        *            started, so a segment left behind by an earlier
+        *            database instance is never matched.
+        *   \param server The server that holds the tensor
+        *   \param key The key of the tensor
+        *   \returns The identity of the tensor, or an empty string
+        *            if the run ID of the database node is unknown
+        */
+        std::string _segment_id(RedisServer& server, const std::string& key);
+
+        /*!
+        *   \brief Get the name of the segment of a tensor
+        *   \param id The identity of the tensor from _segment_id()
+        *   \returns The name of the segment
+        */
+        static std::string _segment_name(const std::string& id);
+
+        /*!
+        *   \brief The segments mapped by this process, indexed
+        *          by segment name
+        */
+        std::unordered_map<std::string, Mapping> _mappings;
+
+        /*!
+        *   \brief Segments that were replaced after being
+        *          invalidated.  They stay mapped so that the data
+        *          returned from them remain valid.
+        */
+        std::vector<Mapping> _retired;
+
+        /*!
+        *   \brief The run ID of each database node, indexed
+        *          by address
+        */
+        std::unordered_map<std::string, std::string> _run_ids;
+
+        /*!
+        *   \brief Guards the mappings
+        */
+        std::mutex _mutex;
+
+        /*!
+        *   \brief The size of a memory page
+        */
+        size_t _page_size;
+
+        /*!
+        *   \brief Time (in milliseconds) to wait for another
+        *          process to fill a segment before giving up on it
+        */
+        static constexpr int _FILL_TIMEOUT = 30000;
+
+        /*!
+        *   \brief Interval (in milliseconds) between checks of
+        *          a segment that is being filled
+        */
+        static constexpr int _FILL_POLL_INTERVAL = 1;
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_SHAREDTENSORCACHE_H
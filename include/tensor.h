@@ -34,6 +34,7 @@
 #include <stdexcept>
 #include "tensorbase.h"
 #include "sharedmemorylist.h"
+#include "layouttranspose.h"
 #include "srexception.h"
 
 ///@file
@@ -115,6 +116,9 @@ class Tensor : public TensorBase
         /*!
         *   \brief Get a pointer to a specificed memory
         *          view of the Tensor data
+        *   \details The column major view is built once per
+        *            Tensor and the same memory is returned by
+        *            every later request for that layout.
         *   \param mem_layout The MemoryLayout enum describing
         *          the layout of data view
         */
@@ -131,6 +135,24 @@ class Tensor : public TensorBase
                                     std::vector<size_t> dims,
                                     SRMemoryLayout mem_layout);
 
+        /*!
+        *   \brief Fill a user provided memory space with values
+        *          from contiguous (row major) data that are not
+        *          held by a Tensor, such as a database reply
+        *   \details The source data are read once and written
+        *            directly into the requested layout.
+        *   \param src_data Pointer to the contiguous source data
+        *   \param src_dims The dimensions of the source data
+        *   \param data Pointer to the allocated memory space
+        *   \param dims The dimensions of the memory space
+        *   \param mem_layout The memory layout of the provided memory space
+        */
+        static void fill_mem_space(const void* src_data,
+                                   const std::vector<size_t>& src_dims,
+                                   void* data,
+                                   std::vector<size_t> dims,
+                                   SRMemoryLayout mem_layout);
+
     protected:
 
     private:
@@ -174,35 +196,29 @@ class Tensor : public TensorBase
         *                        the flat memory space
         *   \param tensor_data The flat memory structure data
         */
-        void _fill_nested_mem_with_data(void* data,
-                                        size_t* dims,
-                                        size_t n_dims,
-                                        size_t& data_position,
-                                        void* tensor_data);
+        static void _fill_nested_mem_with_data(void* data,
+                                               size_t* dims,
+                                               size_t n_dims,
+                                               size_t& data_position,
+                                               void* tensor_data);
 
         /*!
         *   \brief Builds nested array structure to point
         *          to the provided flat, contiguous memory
-        *          space.  The space is returned via the data
-        *          input pointer.
-        *   \details The initial caller SHOULD NOT use
-        *            the return value.  The return value
-        *            is for recursive value passing only.
-        *   \param data A pointer to the pointer where
-        *               data should be stored
-        *   \param dims An array of integer dimension values
-        *   \param n_dims The number of dimension left to
-        *                 iterate through
+        *          space.
+        *   \details All of the pointer arrays are placed in a
+        *            single allocation, one level after another,
+        *            so that each level is stored contiguously in
+        *            the order it is traversed.
+        *   \param dims The dimensions of the nested structure
         *   \param contiguous_mem The contiguous memory that
         *                         the nested structure points to
-        *   \returns A pointer that is for recursive functionality
-        *            only.  The initial caller SHOULD NOT use
-        *            this pointer.
+        *   \returns A pointer to the outermost level of the
+        *            nested structure, or contiguous_mem for a
+        *            single dimension
         */
-        T* _build_nested_memory(void** data,
-                                size_t* dims,
-                                size_t n_dims,
-                                T* contiguous_mem);
+        void* _build_nested_memory(const std::vector<size_t>& dims,
+                                   T* contiguous_mem);
 
         /*!
         *   \brief Set the tensor data from a src memory location.
@@ -237,64 +253,9 @@ class Tensor : public TensorBase
         *   \param c_data A pointer to the row major memory space
         *   \param dims The dimensions of the tensor
         */
-        void _c_to_f_memcpy(T* f_data,
-                            T* c_data,
-                            const std::vector<size_t>& dims);
-
-        /*!
-        *   \brief This is a recursive function used to copy
-        *          fortran column major memory to c-style row
-        *          major memory
-        *   \param c_data A pointer to the row major memory space
-        *   \param f_data A pointer to the col major memory space
-        *   \param dims The dimensions of the tensor
-        *   \param dim_positions The current position in each
-        *                        dimension
-        *   \param current_dim The index of the current dimension
-        */
-        void _f_to_c(T* c_data,
-                     T* f_data,
-                     const std::vector<size_t>& dims,
-                     std::vector<size_t> dim_positions,
-                     size_t current_dim);
-
-        /*!
-        *   \brief This is a recursive function used to
-        *          copy c-style row major memory to fortran
-        *          column major memory
-        *   \param f_data A pointer to the col major memory space
-        *   \param c_data A pointer to the row major memory space
-        *   \param dims The dimensions of the tensor
-        *   \param dim_positions The current position in each
-        *                        dimension
-        *   \param current_dim The index of the current dimension
-        */
-        void _c_to_f(T* f_data,
-                     T* c_data,
-                     const std::vector<size_t>& dims,
-                     std::vector<size_t> dim_positions,
-                     size_t current_dim);
-
-        /*!
-        *   \brief Calculate the contiguous array position
-        *          for a column major position
-        *   \param dims The tensor dimensions
-        *   \param dim_positions The current position for each
-        *                        dimension
-        *   \returns The contiguous memory index position
-        */
-        inline size_t _f_index(const std::vector<size_t>& dims,
-                               const std::vector<size_t>& dim_positions);
-
-        /*!
-        *   \brief  Calculate the contiguous array position
-        *           for a row major position
-        *   \param dims The tensor dimensions
-        *   \param dim_positions The current position for each dimension
-        *   \returns The contiguous memory index position
-        */
-        inline size_t _c_index(const std::vector<size_t>& dims,
-                               const std::vector<size_t>& dim_positions);
+        static void _c_to_f_memcpy(T* f_data,
+                                   T* c_data,
+                                   const std::vector<size_t>& dims);
 
         /*!
         *   \brief Get the total number of bytes of the data
@@ -311,6 +272,13 @@ class Tensor : public TensorBase
         *   \brief Memory allocated for f nested tensor memory views
         */
         SharedMemoryList<T> _f_mem_views;
+
+        /*!
+        *   \brief The column major view of the tensor data
+        *          returned by data_view(), which is built on
+        *          the first request and reused afterwards
+        */
+        T* _f_data_view = NULL;
 };
 
 #include "tensor.tcc"
@@ -60,6 +60,8 @@ Tensor<T>::Tensor(Tensor<T>&& tensor) : TensorBase(std::move(tensor))
 {
     _c_mem_views = std::move(tensor._c_mem_views);
     _f_mem_views = std::move(tensor._f_mem_views);
+    _f_data_view = tensor._f_data_view;
+    tensor._f_data_view = NULL;
 }
 
 // Tensor copy assignment operator
@@ -75,6 +77,7 @@ Tensor<T>& Tensor<T>::operator=(const Tensor<T>& tensor)
     _set_tensor_data(tensor._data, tensor._dims, SRMemLayoutContiguous);
     _c_mem_views = tensor._c_mem_views;
     _f_mem_views = tensor._f_mem_views;
+    _f_data_view = NULL;
 
     // Done
     return *this;
@@ -92,6 +95,8 @@ Tensor<T>& Tensor<T>::operator=(Tensor<T>&& tensor)
     TensorBase::operator=(std::move(tensor));
     _c_mem_views = std::move(tensor._c_mem_views);
     _f_mem_views = std::move(tensor._f_mem_views);
+    _f_data_view = tensor._f_data_view;
+    tensor._f_data_view = NULL;
 
     // Done
     return *this;
@@ -134,7 +139,13 @@ void* Tensor<T>::data_view(const SRMemoryLayout mem_layout)
        The internal row major format will
        be copied into a new allocated memory
        space that is the transpose (column major)
-       of the row major layout.
+       of the row major layout.  The transposed
+       memory space is kept and returned by
+       later calls for this layout.
+    4) MemoryLayout::fortran_nested :
+       A nested structure of pointers, indexed
+       with the last dimension outermost, into
+       the fortran_contiguous view.
     */
 
     void* ptr = NULL;
@@ -144,14 +155,23 @@ void* Tensor<T>::data_view(const SRMemoryLayout mem_layout)
             ptr = _data;
             break;
         case SRMemLayoutFortranContiguous:
-            ptr = _f_mem_views.allocate_bytes(_n_data_bytes());
-            _c_to_f_memcpy((T*)ptr, (T*)_data, _dims);
+            if (_f_data_view == NULL) {
+                T* f_data = _f_mem_views.allocate_bytes(_n_data_bytes());
+                _c_to_f_memcpy(f_data, (T*)_data, _dims);
+                _f_data_view = f_data;
+            }
+            ptr = _f_data_view;
             break;
         case SRMemLayoutNested:
-            _build_nested_memory(&ptr,
-                                 _dims.data(),
-                                 _dims.size(),
-                                 (T*)_data);
+            ptr = _build_nested_memory(_dims, (T*)_data);
+            break;
+        case SRMemLayoutFortranNested: {
+            // The outermost level indexes the last dimension
+            // of the column major view
+            std::vector<size_t> f_dims(_dims.rbegin(), _dims.rend());
+            ptr = _build_nested_memory(
+                f_dims, (T*)data_view(SRMemLayoutFortranContiguous));
+            }
             break;
         default:
             throw SRRuntimeException("Unsupported MemoryLayout value in "\
@@ -171,6 +191,17 @@ void Tensor<T>::fill_mem_space(void* data,
                                  "a data array to fill with.");
     }
 
+    fill_mem_space(_data, _dims, data, dims, mem_layout);
+}
+
+// Fill a user provided memory space with values from contiguous data
+template <class T>
+void Tensor<T>::fill_mem_space(const void* src_data,
+                               const std::vector<size_t>& src_dims,
+                               void* data,
+                               std::vector<size_t> dims,
+                               SRMemoryLayout mem_layout)
+{
     if (dims.size() == 0) {
         throw SRRuntimeException("The dimensions must have nonzero size");
     }
@@ -186,7 +217,10 @@ void Tensor<T>::fill_mem_space(void* data,
     }
 
     // Make sure there is space for all the data
-    if (n_values != num_values()) {
+    size_t n_src_values = 1;
+    for (it = src_dims.cbegin(); it != src_dims.cend(); it++)
+        n_src_values *= (*it);
+    if (n_values != n_src_values) {
         throw SRRuntimeException("The provided dimensions do "\
                                  "not match the size of the "\
                                  "tensor data array");
@@ -195,17 +229,36 @@ void Tensor<T>::fill_mem_space(void* data,
     // Copy over the data
     switch (mem_layout) {
         case SRMemLayoutFortranContiguous:
-            _c_to_f_memcpy((T*)data, (T*)_data, _dims);
+            _c_to_f_memcpy((T*)data, (T*)src_data, src_dims);
             break;
         case SRMemLayoutContiguous:
-            std::memcpy(data, _data, _n_data_bytes());
+            std::memcpy(data, src_data, n_values * sizeof(T));
             break;
         case SRMemLayoutNested: {
             size_t starting_position = 0;
             _fill_nested_mem_with_data(data, dims.data(),
                                              dims.size(),
                                              starting_position,
-                                             _data);
+                                             (void*)src_data);
+            }
+            break;
+        case SRMemLayoutFortranNested: {
+            // Transpose into a staging space and then copy
+            // each innermost array into the nested structure
+            std::vector<T> f_data;
+            try {
+                f_data.resize(n_values);
+            }
+            catch (std::bad_alloc& e) {
+                throw SRBadAllocException("fortran nested staging memory");
+            }
+            _c_to_f_memcpy(f_data.data(), (T*)src_data, src_dims);
+            std::vector<size_t> f_dims(dims.rbegin(), dims.rend());
+            size_t starting_position = 0;
+            _fill_nested_mem_with_data(data, f_dims.data(),
+                                       f_dims.size(),
+                                       starting_position,
+                                       f_data.data());
             }
             break;
         default:
@@ -261,32 +314,50 @@ void Tensor<T>::_fill_nested_mem_with_data(void* data,
 }
 
 // Builds nested array structure to point to the provided flat, contiguous
-// memory space.  The space is returned via the data input pointer.
+// memory space.  The pointer arrays of every level share one allocation.
 template <class T>
-T* Tensor<T>::_build_nested_memory(void** data,
-                                   size_t* dims,
-                                   size_t n_dims,
-                                   T* contiguous_mem)
+void* Tensor<T>::_build_nested_memory(const std::vector<size_t>& dims,
+                                      T* contiguous_mem)
 {
-    if (dims == NULL) {
+    if (dims.size() == 0) {
         throw SRRuntimeException("Missing dims in call to "\
                                  "_build_nested_memory");
     }
-    if (n_dims > 1) {
-        T** new_data = _c_mem_views.allocate(dims[0]);
-        if (new_data == NULL)
-            throw SRBadAllocException("nested memory for tensor");
-        (*data) = reinterpret_cast<void*>(new_data);
-        for (size_t i = 0; i < dims[0]; i++)
-            contiguous_mem = _build_nested_memory(
-                reinterpret_cast<void**>(&new_data[i]), &dims[1],
-                n_dims - 1, contiguous_mem);
+    if (dims.size() == 1)
+        return contiguous_mem;
+
+    // Level k holds one pointer per position of dims[0..k]
+    size_t n_levels = dims.size() - 1;
+    std::vector<size_t> level_sizes(n_levels);
+    size_t n_pointers = 0;
+    size_t level_size = 1;
+    for (size_t k = 0; k < n_levels; k++) {
+        level_size *= dims[k];
+        level_sizes[k] = level_size;
+        n_pointers += level_size;
     }
-    else {
-        (*data) = (T*)contiguous_mem;
-        contiguous_mem += dims[0];
+
+    T** pointers = _c_mem_views.allocate(n_pointers);
+    if (pointers == NULL)
+        throw SRBadAllocException("nested memory for tensor");
+
+    // Point each level into the following level, and
+    // the final level into the contiguous memory
+    T** level = pointers;
+    for (size_t k = 0; k < n_levels; k++) {
+        T** next_level = level + level_sizes[k];
+        size_t stride = dims[k + 1];
+        if (k + 1 < n_levels) {
+            for (size_t i = 0; i < level_sizes[k]; i++)
+                level[i] = reinterpret_cast<T*>(next_level + i * stride);
+        }
+        else {
+            for (size_t i = 0; i < level_sizes[k]; i++)
+                level[i] = contiguous_mem + i * stride;
+        }
+        level = next_level;
     }
-    return contiguous_mem;
+    return reinterpret_cast<void*>(pointers);
 }
 
 // Set the tensor data from a src memory location.
@@ -315,6 +386,22 @@ void Tensor<T>::_set_tensor_data(void* src_data,
             _copy_nested_to_contiguous(
                 src_data, dims.data(), dims.size(), _data);
             break;
+        case SRMemLayoutFortranNested: {
+            // Gather the innermost arrays into column major
+            // order and then transpose them into the tensor
+            std::vector<T> f_data;
+            try {
+                f_data.resize(n_values);
+            }
+            catch (std::bad_alloc& e) {
+                throw SRBadAllocException("fortran nested staging memory");
+            }
+            std::vector<size_t> f_dims(dims.rbegin(), dims.rend());
+            _copy_nested_to_contiguous(
+                src_data, f_dims.data(), f_dims.size(), f_data.data());
+            _f_to_c_memcpy((T*)_data, f_data.data(), dims);
+            }
+            break;
         default:
             throw SRRuntimeException("Invalid memory layout in call "\
                                      "to _set_tensor_data");
@@ -337,8 +424,7 @@ void Tensor<T>::_f_to_c_memcpy(T* c_data,
     if (c_data == NULL || f_data == NULL) {
         throw SRRuntimeException("Invalid buffer suppplied to _f_to_c_memcpy");
     }
-    std::vector<size_t> dim_positions(dims.size(), 0);
-    _f_to_c(c_data, f_data, dims, dim_positions, 0);
+    LayoutTranspose<T>::f_to_c(c_data, f_data, dims);
 }
 
 // Copy a c-style array memory space (row major) to a
@@ -351,99 +437,7 @@ void Tensor<T>::_c_to_f_memcpy(T* f_data,
     if (c_data == NULL || f_data == NULL) {
         throw SRRuntimeException("Invalid buffer suppplied to _c_to_f_memcpy");
     }
-    std::vector<size_t> dim_positions(dims.size(), 0);
-    _c_to_f(f_data, c_data, dims, dim_positions, 0);
-}
-
-// Copy fortran column major memory to c-style row major memory recursively
-template <class T>
-void Tensor<T>::_f_to_c(T* c_data,
-                        T* f_data,
-                        const std::vector<size_t>& dims,
-                        std::vector<size_t> dim_positions,
-                        size_t current_dim)
-{
-    if (c_data == NULL || f_data == NULL) {
-        throw SRRuntimeException("Invalid buffer suppplied to _f_to_c");
-    }
-    size_t start = dim_positions[current_dim];
-    size_t end = dims[current_dim];
-    bool more_dims = (current_dim + 1 != dims.size());
-
-    for (size_t i = start; i < end; i++) {
-        if (more_dims)
-            _f_to_c(c_data, f_data, dims, dim_positions,
-                          current_dim + 1);
-        else {
-            size_t f_index = _f_index(dims, dim_positions);
-            size_t c_index = _c_index(dims, dim_positions);
-            c_data[c_index] = f_data[f_index];
-        }
-        dim_positions[current_dim]++;
-    }
-}
-
-// Copy c-style row major memory to fortran column major memory recursively
-template <class T>
-void Tensor<T>::_c_to_f(T* f_data,
-                        T* c_data,
-                        const std::vector<size_t>& dims,
-                        std::vector<size_t> dim_positions,
-                        size_t current_dim)
-{
-    if (c_data == NULL || f_data == NULL) {
-        throw SRRuntimeException("Invalid buffer suppplied to _f_to_c");
-    }
-    size_t start = dim_positions[current_dim];
-    size_t end = dims[current_dim];
-    bool more_dims = (current_dim + 1 != dims.size());
-
-    for (size_t i = start; i < end; i++) {
-        if (more_dims) {
-            _c_to_f(f_data, c_data, dims, dim_positions,
-                          current_dim + 1);
-        }
-        else {
-            size_t f_index = _f_index(dims, dim_positions);
-            size_t c_index = _c_index(dims, dim_positions);
-            f_data[f_index] = c_data[c_index];
-        }
-        dim_positions[current_dim]++;
-    }
-}
-
-// Calculate the contiguous array position for a column major position
-template <class T>
-inline size_t Tensor<T>::_f_index(const std::vector<size_t>& dims,
-                                  const std::vector<size_t>& dim_positions)
-{
-    size_t position = 0;
-
-    for (size_t k = 0; k < dims.size(); k++) {
-        size_t sum_product = dim_positions[k];
-        for (size_t m = 0; m < k; m++) {
-            sum_product *= dims[m];
-        }
-        position += sum_product;
-    }
-    return position;
-}
-
-// Calculate the contiguous array position for a row major position
-template <class T>
-inline size_t Tensor<T>::_c_index(const std::vector<size_t>& dims,
-                                  const std::vector<size_t>& dim_positions)
-{
-    size_t position = 0;
-
-    for(size_t k = 0; k < dims.size(); k++) {
-        size_t sum_product = dim_positions[k];
-        for(size_t m = k + 1; m < dims.size(); m++) {
-            sum_product *= dims[m];
-        }
-        position += sum_product;
-    }
-    return position;
+    LayoutTranspose<T>::c_to_f(f_data, c_data, dims);
 }
 
 #endif //SMARTREDIS_TENSOR_TCC
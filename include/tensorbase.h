@@ -34,6 +34,7 @@
 #include <unordered_map>
 #include <string>
 #include <string_view>
+#include <cstdint>
 #include <stdexcept>
 #include "sr_enums.h"
 
@@ -77,6 +78,17 @@ static const std::unordered_map<SRTensorType, std::string>
         {SRTensorTypeUint16, DATATYPE_TENSOR_STR_UINT16},
         {SRTensorTypeUint8, DATATYPE_TENSOR_STR_UINT8} };
 
+static const std::unordered_map<SRTensorType, size_t>
+    TENSOR_TYPE_SIZE_MAP{
+        {SRTensorTypeDouble, sizeof(double)},
+        {SRTensorTypeFloat, sizeof(float)},
+        {SRTensorTypeInt64, sizeof(int64_t)},
+        {SRTensorTypeInt32, sizeof(int32_t)},
+        {SRTensorTypeInt16, sizeof(int16_t)},
+        {SRTensorTypeInt8, sizeof(int8_t)},
+        {SRTensorTypeUint16, sizeof(uint16_t)},
+        {SRTensorTypeUint8, sizeof(uint8_t)} };
+
 class TensorBase;
 
 /*!
@@ -214,6 +226,17 @@ class TensorBase{
                                     std::vector<size_t> dims,
                                     SRMemoryLayout mem_layout) = 0;
 
+        /*!
+        *   \brief Validate inputs for a tensor
+        *   \param src_data A pointer to the data source for the tensor
+        *   \param name The name used to reference the tensor
+        *   \param dims The dimensions of the data
+        *   \throw SmartRedis::Exception if any input is invalid
+        */
+        static void check_inputs(const void* src_data,
+                                 const std::string& name,
+                                 const std::vector<size_t>& dims);
+
 
         protected:
 
@@ -245,16 +268,6 @@ class TensorBase{
 
         private:
 
-        /*!
-        *   \brief Validate inputs for a tensor
-        *   \param src_data A pointer to the data source for the tensor
-        *   \param name The name used to reference the tensor
-        *   \param dims The dimensions of the data
-        */
-        inline void _check_inputs(const void* src_data,
-                                  const std::string& name,
-                                  const std::vector<size_t>& dims);
-
         /*!
         *   \brief Set the tensor data from a src memory location
         *   \param src_data A pointer to the data source for the tensor
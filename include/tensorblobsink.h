@@ -0,0 +1,190 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SMARTREDIS_TENSORBLOBSINK_H
+#define SMARTREDIS_TENSORBLOBSINK_H
+
+#include <vector>
+#include <sw/redis++/redis++.h>
+#include "sr_enums.h"
+
+///@file
+
+namespace SmartRedis {
+
+class TensorBlobSink;
+
+/*!
+*   \brief The TensorBlobSink class receives the BLOB of an
+*          AI.TENSORGET META BLOB reply while the reply is parsed.
+*   \details While attached to a hiredis context, the sink replaces
+*            the reply object function that creates strings.  When
+*            the BLOB element arrives and the tensor metadata that
+*            precede it match the destination memory space, the
+*            BLOB is written straight into that memory space and
+*            the reply receives an empty string in its place.
+*            Otherwise, the reply is built as usual so that the
+*            mismatch can be reported by the caller.
+*
+*            hiredis hands a bulk string out only once its read
+*            buffer holds all of it, so the BLOB is still buffered
+*            there while it is read.  The sink removes the copy of
+*            the BLOB into the reply and the separate pass that
+*            unpacks the reply, not that buffer.
+*/
+class TensorBlobSink
+{
+    public:
+
+        /*!
+        *   \brief TensorBlobSink constructor
+        *   \param data The memory space to fill with tensor data
+        *   \param dims The dimensions of the memory space
+        *   \param type The tensor type of the memory space
+        *   \param mem_layout The memory layout of the memory space
+        */
+        TensorBlobSink(void* data,
+                       const std::vector<size_t>& dims,
+                       const SRTensorType type,
+                       const SRMemoryLayout mem_layout);
+
+        /*!
+        *   \brief TensorBlobSink copy constructor is not allowed
+        *   \param sink The TensorBlobSink to copy for construction
+        */
+        TensorBlobSink(const TensorBlobSink& sink) = delete;
+
+        /*!
+        *   \brief TensorBlobSink copy assignment is not allowed
+        *   \param sink The TensorBlobSink to copy for assignment
+        */
+        TensorBlobSink& operator=(const TensorBlobSink& sink) = delete;
+
+        /*!
+        *   \brief TensorBlobSink destructor.  Detaches the sink
+        *          if it is still attached.
+        */
+        ~TensorBlobSink();
+
+        /*!
+        *   \brief Attach the sink to the reply reader of a
+        *          hiredis context
+        *   \details Only the replies read while the sink is attached
+        *            are affected, so the sink must be detached before
+        *            the connection is used for anything else.
+        *   \param context The hiredis context to attach to
+        */
+        void attach(redisContext* context);
+
+        /*!
+        *   \brief Restore the reply reader of the attached
+        *          hiredis context
+        */
+        void detach();
+
+        /*!
+        *   \brief Check whether the memory space has been filled
+        *   \returns True if the BLOB was written to the memory space
+        */
+        bool filled() const;
+
+    private:
+
+        /*!
+        *   \brief Reply object function that creates strings,
+        *          diverting the BLOB of an AI.TENSORGET reply
+        *   \param task The hiredis read task of the string
+        *   \param str The string data
+        *   \param len The length of the string
+        *   \returns The reply object for the string
+        */
+        static void* _create_string(const redisReadTask* task,
+                                    char* str,
+                                    size_t len);
+
+        /*!
+        *   \brief Fill the memory space with the BLOB if the
+        *          preceding tensor metadata match it
+        *   \param meta The partially built AI.TENSORGET reply
+        *   \param blob The BLOB data
+        *   \param len The length of the BLOB data
+        *   \returns True if the memory space was filled
+        */
+        bool _fill(const redisReply* meta, const char* blob, size_t len);
+
+        /*!
+        *   \brief The memory space to fill
+        */
+        void* _data;
+
+        /*!
+        *   \brief The dimensions of the memory space
+        */
+        std::vector<size_t> _dims;
+
+        /*!
+        *   \brief The tensor type of the memory space
+        */
+        SRTensorType _type;
+
+        /*!
+        *   \brief The memory layout of the memory space
+        */
+        SRMemoryLayout _mem_layout;
+
+        /*!
+        *   \brief Whether the memory space has been filled
+        */
+        bool _filled;
+
+        /*!
+        *   \brief The reader the sink is attached to, or NULL
+        */
+        redisReader* _reader;
+
+        /*!
+        *   \brief The reply object functions of the reader
+        *          before the sink was attached
+        */
+        redisReplyObjectFunctions* _default_fn;
+
+        /*!
+        *   \brief The private data of the reader before
+        *          the sink was attached
+        */
+        void* _default_privdata;
+
+        /*!
+        *   \brief The reply object functions used while attached
+        */
+        redisReplyObjectFunctions _fn;
+};
+
+} //namespace SmartRedis
+
+#endif //SMARTREDIS_TENSORBLOBSINK_H
@@ -280,6 +280,58 @@ SRError put_tensor(void* c_client,
   return result;
 }
 
+// Put multiple tensors of specified types into the database
+extern "C"
+SRError put_tensors(void* c_client,
+                    const char** names,
+                    const size_t* name_lengths,
+                    void** data,
+                    const size_t** dims,
+                    const size_t* n_dims,
+                    const SRTensorType* types,
+                    const SRMemoryLayout* mem_layouts,
+                    const size_t n_tensors)
+{
+  SRError result = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && names != NULL &&
+                    name_lengths != NULL && data != NULL &&
+                    dims != NULL && n_dims != NULL &&
+                    types != NULL && mem_layouts != NULL);
+
+    std::vector<std::string> name_vec;
+    std::vector<void*> data_vec;
+    std::vector<std::vector<size_t>> dims_vec;
+    for (size_t i = 0; i < n_tensors; i++) {
+      if (names[i] == NULL || data[i] == NULL || dims[i] == NULL) {
+        throw SRParameterException(
+          std::string("Tensor ") + std::to_string(i) +
+          " has a NULL name, data, or dims");
+      }
+      name_vec.push_back(std::string(names[i], name_lengths[i]));
+      data_vec.push_back(data[i]);
+      dims_vec.push_back(std::vector<size_t>(dims[i], dims[i] + n_dims[i]));
+    }
+    std::vector<SRTensorType> type_vec(types, types + n_tensors);
+    std::vector<SRMemoryLayout> layout_vec(mem_layouts, mem_layouts + n_tensors);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->put_tensors(name_vec, data_vec, dims_vec, type_vec, layout_vec);
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    result = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    result = SRInternalError;
+  }
+
+  return result;
+}
+
 // Get a tensor of a specified type from the database
 extern "C"
 SRError get_tensor(void* c_client,
@@ -354,6 +406,58 @@ SRError unpack_tensor(void* c_client,
   return outcome;
 }
 
+// Retrieve multiple tensors into caller-provided memory spaces
+extern "C"
+SRError unpack_tensors(void* c_client,
+                       const char** names,
+                       const size_t* name_lengths,
+                       void** results,
+                       const size_t** dims,
+                       const size_t* n_dims,
+                       const SRTensorType* types,
+                       const SRMemoryLayout* mem_layouts,
+                       const size_t n_tensors)
+{
+  SRError outcome = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && names != NULL &&
+                    name_lengths != NULL && results != NULL &&
+                    dims != NULL && n_dims != NULL &&
+                    types != NULL && mem_layouts != NULL);
+
+    std::vector<std::string> name_vec;
+    std::vector<void*> result_vec;
+    std::vector<std::vector<size_t>> dims_vec;
+    for (size_t i = 0; i < n_tensors; i++) {
+      if (names[i] == NULL || results[i] == NULL || dims[i] == NULL) {
+        throw SRParameterException(
+          std::string("Tensor ") + std::to_string(i) +
+          " has a NULL name, result, or dims");
+      }
+      name_vec.push_back(std::string(names[i], name_lengths[i]));
+      result_vec.push_back(results[i]);
+      dims_vec.push_back(std::vector<size_t>(dims[i], dims[i] + n_dims[i]));
+    }
+    std::vector<SRTensorType> type_vec(types, types + n_tensors);
+    std::vector<SRMemoryLayout> layout_vec(mem_layouts, mem_layouts + n_tensors);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    s->unpack_tensors(name_vec, result_vec, dims_vec, type_vec, layout_vec);
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    outcome = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    outcome = SRInternalError;
+  }
+
+  return outcome;
+}
+
 // Rename a tensor from key to new_key
 extern "C"
 SRError rename_tensor(void* c_client, const char* key,
@@ -1237,3 +1341,311 @@ SRError use_tensor_ensemble_prefix(void* c_client, bool use_prefix)
 
   return result;
 }
+
+// The state of an asynchronous request made through the C interface.
+// Requests that retrieve a DataSet also record where the caller
+// wants the new DataSet pointer to be written.
+struct CAsyncRequest
+{
+  std::future<void> done;
+  std::future<DataSet> dataset_done;
+  void** dataset;
+};
+
+// Allocate a request handle for a request without a result
+static void* _new_request(std::future<void>&& done)
+{
+  try {
+    CAsyncRequest* r = new CAsyncRequest;
+    r->done = std::move(done);
+    r->dataset = NULL;
+    return reinterpret_cast<void*>(r);
+  }
+  catch (const std::bad_alloc& e) {
+    throw SRBadAllocException("asynchronous request");
+  }
+}
+
+// Put a tensor into the database asynchronously
+extern "C"
+SRError put_tensor_async(void* c_client,
+                         const char* key,
+                         const size_t key_length,
+                         void* data,
+                         const size_t* dims,
+                         const size_t n_dims,
+                         const SRTensorType type,
+                         const SRMemoryLayout mem_layout,
+                         void** request)
+{
+  SRError result = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && key != NULL &&
+                    data != NULL && dims != NULL && request != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string key_str(key, key_length);
+
+    std::vector<size_t> dims_vec;
+    dims_vec.assign(dims, dims + n_dims);
+
+    *request = _new_request(
+      s->put_tensor_async(key_str, data, dims_vec, type, mem_layout));
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    result = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    result = SRInternalError;
+  }
+
+  return result;
+}
+
+// Fill a pre-allocated memory space with tensor data asynchronously
+extern "C"
+SRError unpack_tensor_async(void* c_client,
+                            const char* key,
+                            const size_t key_length,
+                            void* result,
+                            const size_t* dims,
+                            const size_t n_dims,
+                            const SRTensorType type,
+                            const SRMemoryLayout mem_layout,
+                            void** request)
+{
+  SRError outcome = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && key != NULL && result != NULL &&
+                    dims != NULL && request != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string key_str(key, key_length);
+
+    std::vector<size_t> dims_vec;
+    dims_vec.assign(dims, dims + n_dims);
+
+    *request = _new_request(
+      s->unpack_tensor_async(key_str, result, dims_vec, type, mem_layout));
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    outcome = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    outcome = SRInternalError;
+  }
+
+  return outcome;
+}
+
+// Run a model in the database asynchronously
+extern "C"
+SRError run_model_async(void* c_client,
+                        const char* key,
+                        const size_t key_length,
+                        const char** inputs,
+                        const size_t* input_lengths,
+                        const size_t n_inputs,
+                        const char** outputs,
+                        const size_t* output_lengths,
+                        const size_t n_outputs,
+                        void** request)
+{
+  SRError result = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && key != NULL &&
+                    inputs != NULL && input_lengths != NULL &&
+                    outputs != NULL && output_lengths != NULL &&
+                    request != NULL);
+
+    // Inputs and outputs are mandatory for run_model
+    for (size_t i = 0; i < n_inputs; i++){
+      if (inputs[i] == NULL || input_lengths[i] == 0) {
+        throw SRParameterException(
+          std::string("inputs[") + std::to_string(i) + "] is NULL or empty");
+      }
+    }
+    for (size_t i = 0; i < n_outputs; i++) {
+      if (outputs[i] == NULL || output_lengths[i] == 0) {
+        throw SRParameterException(
+          std::string("outputs[") + std::to_string(i) + "] is NULL or empty");
+      }
+    }
+
+    std::string key_str(key, key_length);
+
+    std::vector<std::string> input_vec;
+    for (size_t i = 0; i < n_inputs; i++) {
+      input_vec.push_back(std::string(inputs[i], input_lengths[i]));
+    }
+
+    std::vector<std::string> output_vec;
+    for (size_t i = 0; i < n_outputs; i++) {
+      output_vec.push_back(std::string(outputs[i], output_lengths[i]));
+    }
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    *request = _new_request(
+      s->run_model_async(key_str, input_vec, output_vec));
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    result = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    result = SRInternalError;
+  }
+
+  return result;
+}
+
+// Put a dataset into the database asynchronously
+extern "C"
+SRError put_dataset_async(void* c_client, void* dataset, void** request)
+{
+  SRError result = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && dataset != NULL && request != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    DataSet* d = reinterpret_cast<DataSet*>(dataset);
+
+    *request = _new_request(s->put_dataset_async(*d));
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    result = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    result = SRInternalError;
+  }
+
+  return result;
+}
+
+// Retrieve a dataset from the database asynchronously.  The dataset
+// pointer is written when the request is completed with wait_request().
+extern "C"
+SRError get_dataset_async(void* c_client, const char* name,
+                          const size_t name_length, void** dataset,
+                          void** request)
+{
+  SRError result = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(c_client != NULL && name != NULL && dataset != NULL &&
+                    request != NULL);
+
+    Client* s = reinterpret_cast<Client*>(c_client);
+    std::string dataset_name(name, name_length);
+
+    std::future<DataSet> dataset_done = s->get_dataset_async(dataset_name);
+    CAsyncRequest* r = NULL;
+    try {
+      r = new CAsyncRequest;
+    }
+    catch (const std::bad_alloc& e) {
+      throw SRBadAllocException("asynchronous request");
+    }
+    r->dataset_done = std::move(dataset_done);
+    r->dataset = dataset;
+    *dataset = NULL;
+    *request = reinterpret_cast<void*>(r);
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    result = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    result = SRInternalError;
+  }
+
+  return result;
+}
+
+// Wait for an asynchronous request to complete and release it
+extern "C"
+SRError wait_request(void** request)
+{
+  SRError result = SRNoError;
+  CAsyncRequest* r = NULL;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(request != NULL && *request != NULL);
+
+    r = reinterpret_cast<CAsyncRequest*>(*request);
+    if (r->dataset != NULL) {
+      try {
+        *(r->dataset) = reinterpret_cast<void*>(
+          new DataSet(r->dataset_done.get()));
+      }
+      catch (const std::bad_alloc& e) {
+        throw SRBadAllocException("dataset allocation");
+      }
+    }
+    else {
+      r->done.get();
+    }
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    result = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    result = SRInternalError;
+  }
+
+  // The request is released whether or not it succeeded
+  if (r != NULL) {
+    delete r;
+    *request = NULL;
+  }
+
+  return result;
+}
+
+// Check whether an asynchronous request has completed
+extern "C"
+SRError test_request(void* request, bool* completed)
+{
+  SRError result = SRNoError;
+  try
+  {
+    // Sanity check params
+    SR_CHECK_PARAMS(request != NULL && completed != NULL);
+
+    CAsyncRequest* r = reinterpret_cast<CAsyncRequest*>(request);
+    std::future_status status = (r->dataset != NULL) ?
+      r->dataset_done.wait_for(std::chrono::seconds(0)) :
+      r->done.wait_for(std::chrono::seconds(0));
+    *completed = (status == std::future_status::ready);
+  }
+  catch (const Exception& e) {
+    SRSetLastError(e);
+    result = e.to_error_code();
+  }
+  catch (...) {
+    SRSetLastError(SRInternalException("Unknown exception occurred"));
+    result = SRInternalError;
+  }
+
+  return result;
+}
@@ -35,7 +35,11 @@ using namespace SmartRedis;
 // Constructor
 Client::Client(bool cluster)
     : _redis_cluster(cluster ? new RedisCluster() : NULL),
-      _redis(cluster ? NULL : new Redis())
+      _redis(cluster ? NULL : new Redis()),
+      _async_queue(NULL),
+      _read_cache(NULL),
+      _shared_tensors(NULL),
+      _use_shared_tensors(false)
 {
     // A std::bad_alloc exception on the initializer will be caught
     // by the call to new for the client
@@ -51,6 +55,23 @@ Client::Client(bool cluster)
 // Destructor
 Client::~Client()
 {
+    // Drain outstanding asynchronous requests while the
+    // server connection they use is still alive
+    if (_async_queue != NULL)
+    {
+        delete _async_queue;
+        _async_queue = NULL;
+    }
+    if (_read_cache != NULL)
+    {
+        delete _read_cache;
+        _read_cache = NULL;
+    }
+    if (_shared_tensors != NULL)
+    {
+        delete _shared_tensors;
+        _shared_tensors = NULL;
+    }
     if (_redis_cluster != NULL)
     {
         delete _redis_cluster;
@@ -89,11 +110,13 @@ DataSet Client::get_dataset(const std::string& name)
 
     std::vector<std::string> tensor_names = dataset.get_tensor_names();
 
-    // Retrieve DataSet tensors and fill the DataSet object
+    // Retrieve DataSet tensors with a single pipeline (all of the keys
+    // share the DataSet hash tag) and fill the DataSet object
+    std::vector<std::string> tensor_keys =
+        _build_dataset_tensor_keys(name, tensor_names, true);
+    std::vector<CommandReply> replies = _get_tensor_replies(tensor_keys);
     for(size_t i = 0; i < tensor_names.size(); i++) {
-        std::string tensor_key =
-            _build_dataset_tensor_key(name, tensor_names[i], true);
-        CommandReply reply = this->_redis_server->get_tensor(tensor_key);
+        CommandReply& reply = replies[i];
         std::vector<size_t> reply_dims = GetTensorCommand::get_dims(reply);
         std::string_view blob = GetTensorCommand::get_data_blob(reply);
         SRTensorType type = GetTensorCommand::get_data_type(reply);
@@ -109,8 +132,60 @@ DataSet Client::get_dataset(const std::string& name)
 void Client::rename_dataset(const std::string& name,
                             const std::string& new_name)
 {
-    copy_dataset(name, new_name);
-    delete_dataset(name);
+    // If the old and new keys cannot be addressed by one RENAME,
+    // the DataSet has to be copied and the original deleted
+    std::string meta_key = _build_dataset_meta_key(name, true);
+    std::string new_meta_key = _build_dataset_meta_key(new_name, false);
+    if (!_redis_server->is_colocated(meta_key, new_meta_key)) {
+        copy_dataset(name, new_name);
+        delete_dataset(name);
+        return;
+    }
+
+    // Get the metadata message and construct DataSet
+    CommandReply reply = _get_dataset_metadata(name);
+    if (reply.n_elements() == 0) {
+        throw SRKeyException("The requested DataSet " +
+                             name + " does not exist.");
+    }
+    DataSet dataset(name);
+    _unpack_dataset_metadata(dataset, reply);
+
+    // Rename the tensors and then the metadata, which holds the ack
+    // field, in one script so that the DataSet is moved as a whole
+    std::vector<std::string> tensor_names = dataset.get_tensor_names();
+    std::vector<std::string> src_keys =
+        _build_dataset_tensor_keys(name, tensor_names, true);
+    std::vector<std::string> dest_keys =
+        _build_dataset_tensor_keys(new_name, tensor_names, false);
+    src_keys.push_back(meta_key);
+    dest_keys.push_back(new_meta_key);
+
+    CompoundCommand rename_cmd;
+    rename_cmd.add_field("EVAL");
+    rename_cmd.add_field(_RENAME_KEYS_SCRIPT);
+    rename_cmd.add_field(std::to_string(2 * src_keys.size()));
+    for (size_t i = 0; i < src_keys.size(); i++)
+        rename_cmd.add_field(src_keys[i], true);
+    for (size_t i = 0; i < dest_keys.size(); i++)
+        rename_cmd.add_field(dest_keys[i], true);
+    reply = _run(rename_cmd);
+    for (size_t i = 0; i < src_keys.size(); i++) {
+        _invalidate_cached(src_keys[i]);
+        _invalidate_cached(dest_keys[i]);
+    }
+    if (reply.has_error() > 0) {
+        throw SRRuntimeException("rename_dataset failed for DataSet " +
+                                 name);
+    }
+
+    // Move the ready signal so that waiters on the new name are woken
+    CommandList cmds;
+    SingleKeyCommand* del_cmd = cmds.add_command<SingleKeyCommand>();
+    del_cmd->add_field("DEL");
+    del_cmd->add_field(_build_dataset_ready_key(name, true), true);
+    _append_dataset_ready_commands(cmds, new_name);
+    (void)_run(cmds);
 }
 
 // Clone the dataset to a new name
@@ -135,6 +210,8 @@ void Client::copy_dataset(const std::string& src_name,
 
     // Clone tensors
     _redis_server->copy_tensors(tensor_src_names, tensor_dest_names);
+    for (size_t i = 0; i < tensor_dest_names.size(); i++)
+        _invalidate_cached(tensor_dest_names[i]);
 
     // Update the DataSet name to the destination name
     // so we can reuse the object for placing metadata
@@ -162,9 +239,11 @@ void Client::delete_dataset(const std::string& name)
     // Build the delete command
     MultiKeyCommand cmd;
 
-    // Delete the metadata (which contains the ack key)
+    // Delete the metadata (which contains the ack key) and
+    // the ready signal used by poll_dataset()
     cmd.add_field("DEL");
     cmd.add_field(_build_dataset_meta_key(dataset.name, true), true);
+    cmd.add_field(_build_dataset_ready_key(dataset.name, true), true);
 
     // Add in all the tensors to be deleted
     std::vector<std::string> tensor_names = dataset.get_tensor_names();
@@ -174,6 +253,8 @@ void Client::delete_dataset(const std::string& name)
 
     // Run the command
     reply = _run(cmd);
+    for (size_t i = 0; i < tensor_keys.size(); i++)
+        _invalidate_cached(tensor_keys[i]);
 
     if (reply.has_error()) {
         throw SRRuntimeException("An error was encountered when executing "\
@@ -190,6 +271,17 @@ void Client::put_tensor(const std::string& key,
 {
     std::string p_key = _build_tensor_key(key, false);
 
+    // Contiguous data are sent straight from the caller's buffer
+    if (mem_layout == SRMemLayoutContiguous) {
+        SingleKeyCommand cmd;
+        _build_put_tensor_command(cmd, p_key, data, dims, type);
+        CommandReply reply = _run(cmd);
+        _invalidate_cached(p_key);
+        if (reply.has_error())
+            throw SRRuntimeException("put_tensor failed");
+        return;
+    }
+
     TensorBase* tensor = NULL;
     try {
         switch (type) {
@@ -231,10 +323,99 @@ void Client::put_tensor(const std::string& key,
     // Cleanup
     delete tensor;
     tensor = NULL;
+    _invalidate_cached(p_key);
     if (reply.has_error())
         throw SRRuntimeException("put_tensor failed");
 }
 
+// Prepare the repeated put of a tensor with a fixed name, type and dimensions
+PreparedPut Client::prepare_put(const std::string& name,
+                                const std::vector<size_t>& dims,
+                                const SRTensorType type)
+{
+    if (name.size() == 0)
+        throw SRParameterException("name is a required parameter "\
+                                   "of prepare_put.");
+    if (dims.size() == 0)
+        throw SRParameterException("dims must have at least one "\
+                                   "dimension in prepare_put.");
+    for (size_t i = 0; i < dims.size(); i++) {
+        if (dims[i] == 0)
+            throw SRParameterException("All dimensions must be greater "\
+                                       "than 0 in prepare_put.");
+    }
+
+    // The data field is left empty until the first put
+    PreparedPut put;
+    put._key = _build_tensor_key(name, false);
+    put._n_bytes = _add_put_tensor_fields(put._cmd, put._key, dims, type);
+    put._cmd.add_field_ptr(std::string_view());
+    put._hash_slot = _redis_server->get_hash_slot(put._key);
+    return put;
+}
+
+// Put a tensor into the database with a PreparedPut
+void Client::put_tensor(PreparedPut& put, const void* data)
+{
+    if (put._n_bytes == 0)
+        throw SRParameterException("The PreparedPut was not created "\
+                                   "by prepare_put.");
+    if (data == NULL)
+        throw SRParameterException("data is a required parameter "\
+                                   "of put_tensor.");
+
+    size_t data_index = (put._cmd.cend() - put._cmd.cbegin()) - 1;
+    put._cmd.set_field_ptr(data_index,
+        std::string_view((const char*)data, put._n_bytes));
+    CommandReply reply = _redis_server->run(put._cmd, put._hash_slot);
+    _invalidate_cached(put._key);
+    if (reply.has_error())
+        throw SRRuntimeException("put_tensor failed");
+}
+
+// Put multiple tensors into the database with pipelined commands
+void Client::put_tensors(const std::vector<std::string>& names,
+                         const std::vector<void*>& data,
+                         const std::vector<std::vector<size_t>>& dims,
+                         const std::vector<SRTensorType>& types,
+                         const std::vector<SRMemoryLayout>& mem_layouts)
+{
+    // Make sure every tensor is fully described
+    size_t n_tensors = names.size();
+    if (data.size() != n_tensors || dims.size() != n_tensors ||
+        types.size() != n_tensors || mem_layouts.size() != n_tensors) {
+        throw SRParameterException("differing size vectors "\
+                                   "passed to put_tensors");
+    }
+
+    // Build a put command for each tensor.  Contiguous data are sent
+    // straight from the caller's buffers; other layouts are staged in
+    // contiguous tensors that live until the commands are sent.
+    TensorPack tensors;
+    CommandList cmds;
+    for (size_t i = 0; i < n_tensors; i++) {
+        std::string p_key = _build_tensor_key(names[i], false);
+        SingleKeyCommand* cmd = cmds.add_command<SingleKeyCommand>();
+        if (mem_layouts[i] == SRMemLayoutContiguous) {
+            _build_put_tensor_command(*cmd, p_key, data[i], dims[i], types[i]);
+            continue;
+        }
+        tensors.add_tensor(p_key, data[i], dims[i], types[i], mem_layouts[i]);
+        TensorBase* tensor = tensors.get_tensor(p_key);
+        cmd->add_field("AI.TENSORSET");
+        cmd->add_field(tensor->name(), true);
+        cmd->add_field(tensor->type_str());
+        cmd->add_fields(tensor->dims());
+        cmd->add_field("BLOB");
+        cmd->add_field_ptr(tensor->buf());
+    }
+
+    // Send the tensors
+    (void)_run(cmds);
+    for (size_t i = 0; i < n_tensors; i++)
+        _invalidate_cached(_build_tensor_key(names[i], false));
+}
+
 // Get the tensor data, dimensions, and type for the provided tensor key.
 // This function will allocate and retain management of the memory for the
 // tensor data.
@@ -280,6 +461,79 @@ void Client::get_tensor(const std::string& key,
         dims[i] = *it;
 }
 
+// Get a read-only view of the contiguous data of a tensor, shared with the
+// other processes of the compute node if the shared tensor cache is used
+void Client::get_shared_tensor(const std::string& name,
+                               const void*& data,
+                               std::vector<size_t>& dims,
+                               SRTensorType& type)
+{
+    std::string get_key = _build_tensor_key(name, true);
+    std::string_view blob;
+    if (_get_shared_tensor(get_key, blob, dims, type, true)) {
+        data = blob.data();
+        return;
+    }
+
+    // Otherwise the client holds a copy of the tensor
+    TensorBase* ptr = _fetch_tensorbase_obj(get_key);
+    dims = ptr->dims();
+    type = ptr->type();
+    data = ptr->data_view(SRMemLayoutContiguous);
+    _tensor_memory.add_tensor(ptr);
+}
+
+// Get the data, dimensions, and type of multiple tensors with pipelined
+// commands. This function will allocate and retain management of the
+// memory for the tensor data.
+void Client::get_tensors(const std::vector<std::string>& keys,
+                         std::vector<void*>& data,
+                         std::vector<std::vector<size_t>>& dims,
+                         std::vector<SRTensorType>& types,
+                         const SRMemoryLayout mem_layout)
+{
+    // Retrieve the TensorBase objects from the database
+    std::vector<std::unique_ptr<TensorBase>> tensors =
+        get_tensor_objects(keys);
+
+    // Set the user values
+    data.clear();
+    dims.clear();
+    types.clear();
+    for (size_t i = 0; i < tensors.size(); i++) {
+        dims.push_back(tensors[i]->dims());
+        types.push_back(tensors[i]->type());
+        data.push_back(tensors[i]->data_view(mem_layout));
+    }
+
+    // Hold the TensorBase objects in memory for memory management
+    for (size_t i = 0; i < tensors.size(); i++) {
+        _tensor_memory.add_tensor(tensors[i].get());
+        (void)tensors[i].release();
+    }
+}
+
+// Retrieve multiple tensors with pipelined commands and return a TensorBase
+// object for each of them. Ownership of the TensorBase objects passes to
+// the caller.
+std::vector<std::unique_ptr<TensorBase>>
+Client::get_tensor_objects(const std::vector<std::string>& names)
+{
+    // Fetch the tensors
+    std::vector<std::string> get_keys;
+    for (size_t i = 0; i < names.size(); i++)
+        get_keys.push_back(_build_tensor_key(names[i], true));
+    std::vector<CommandReply> replies = _get_tensor_replies(get_keys);
+
+    // Build the TensorBase objects
+    std::vector<std::unique_ptr<TensorBase>> tensors;
+    for (size_t i = 0; i < get_keys.size(); i++) {
+        tensors.push_back(std::unique_ptr<TensorBase>(
+            _get_tensorbase_obj(get_keys[i], replies[i])));
+    }
+    return tensors;
+}
+
 // Get tensor data and fill an already allocated array memory space that
 // has the specified MemoryLayout. The provided type and dimensions are
 // checked against retrieved values to ensure the provided memory space is
@@ -291,118 +545,118 @@ void Client::unpack_tensor(const std::string& key,
                            const SRTensorType type,
                            const SRMemoryLayout mem_layout)
 {
-    if (mem_layout == SRMemLayoutContiguous && dims.size() > 1) {
-        throw SRRuntimeException("The destination memory space "\
-                                 "dimension vector should only "\
-                                 "be of size one if the memory "\
-                                 "layout is contiguous.");
-    }
+    _check_unpack_dims(dims, mem_layout);
 
+    // The tensor data are written into the memory space while the
+    // reply is read.  If the tensor does not match the memory space,
+    // the reply holds the data and the mismatch is reported on unpack.
     std::string get_key = _build_tensor_key(key, true);
-    CommandReply reply = _redis_server->get_tensor(get_key);
-
-    std::vector<size_t> reply_dims = GetTensorCommand::get_dims(reply);
-
-    // Make sure we have the right dims to unpack into (Contiguous case)
-    if (mem_layout == SRMemLayoutContiguous ||
-        mem_layout == SRMemLayoutFortranContiguous) {
-        size_t total_dims = 1;
-        for (size_t i = 0; i < reply_dims.size(); i++) {
-            total_dims *= reply_dims[i];
-        }
-        if (total_dims != dims[0] &&
-            mem_layout == SRMemLayoutContiguous) {
-            throw SRRuntimeException("The dimensions of the fetched "\
-                                     "tensor do not match the length of "\
-                                     "the contiguous memory space.");
-        }
+    std::string_view shared_blob;
+    std::vector<size_t> shared_dims;
+    SRTensorType shared_type;
+    if (_get_shared_tensor(get_key, shared_blob, shared_dims, shared_type)) {
+        _unpack_tensor_data(get_key, shared_dims, shared_type, shared_blob,
+                            data, dims, type, mem_layout);
+        return;
     }
+    std::shared_ptr<CommandReply> cached = _get_cached_tensor(get_key);
+    if (cached != nullptr) {
+        _unpack_tensor_reply(get_key, *cached, data, dims, type, mem_layout);
+        return;
+    }
+    TensorBlobSink sink(data, dims, type, mem_layout);
+    CommandReply reply = _redis_server->get_tensor(get_key, sink);
+    if (!sink.filled())
+        _unpack_tensor_reply(get_key, reply, data, dims, type, mem_layout);
+}
 
-    // Make sure we have the right dims to unpack into (Nested case)
-    if (mem_layout == SRMemLayoutNested) {
-        if (dims.size() != reply_dims.size()) {
-            // Same number of dimensions
-            throw SRRuntimeException("The number of dimensions of the  "\
-                                     "fetched tensor, " +
-                                     std::to_string(reply_dims.size()) + " "\
-                                     "does not match the number of "\
-                                     "dimensions of the user memory space, " +
-                                     std::to_string(dims.size()));
-        }
+// Prepare the repeated retrieval of a tensor into memory spaces with
+// fixed dimensions, type and memory layout
+PreparedUnpack Client::prepare_unpack(const std::string& name,
+                                      const std::vector<size_t>& dims,
+                                      const SRTensorType type,
+                                      const SRMemoryLayout mem_layout)
+{
+    if (name.size() == 0)
+        throw SRParameterException("name is a required parameter "\
+                                   "of prepare_unpack.");
+    if (dims.size() == 0)
+        throw SRParameterException("dims must have at least one "\
+                                   "dimension in prepare_unpack.");
+    if (TENSOR_STR_MAP.find(type) == TENSOR_STR_MAP.end())
+        throw SRTypeException("Invalid type for prepare_unpack");
+    _check_unpack_dims(dims, mem_layout);
+
+    PreparedUnpack unpack;
+    unpack._key = _build_tensor_key(name, true);
+    unpack._dims = dims;
+    unpack._type = type;
+    unpack._mem_layout = mem_layout;
+    unpack._hash_slot = _redis_server->get_hash_slot(unpack._key);
+    return unpack;
+}
 
-        // Same size in each dimension
-        for (size_t i = 0; i < reply_dims.size(); i++) {
-            if (dims[i] != reply_dims[i]) {
-                throw SRRuntimeException("The dimensions of the fetched tensor "\
-                                         "do not match the provided "\
-                                         "dimensions of the user memory space.");
-            }
-        }
+// Retrieve a tensor into memory provided by the caller with a PreparedUnpack
+void Client::unpack_tensor(const PreparedUnpack& unpack, void* data)
+{
+    if (unpack._key.size() == 0)
+        throw SRParameterException("The PreparedUnpack was not created "\
+                                   "by prepare_unpack.");
+
+    std::string_view shared_blob;
+    std::vector<size_t> shared_dims;
+    SRTensorType shared_type;
+    if (_get_shared_tensor(unpack._key, shared_blob,
+                           shared_dims, shared_type)) {
+        _unpack_tensor_data(unpack._key, shared_dims, shared_type,
+                            shared_blob, data, unpack._dims,
+                            unpack._type, unpack._mem_layout);
+        return;
     }
+    std::shared_ptr<CommandReply> cached = _get_cached_tensor(unpack._key);
+    if (cached != nullptr) {
+        _unpack_tensor_reply(unpack._key, *cached, data, unpack._dims,
+                             unpack._type, unpack._mem_layout);
+        return;
+    }
+    TensorBlobSink sink(data, unpack._dims, unpack._type, unpack._mem_layout);
+    CommandReply reply =
+        _redis_server->get_tensor(unpack._key, sink, unpack._hash_slot);
+    if (!sink.filled()) {
+        _unpack_tensor_reply(unpack._key, reply, data, unpack._dims,
+                             unpack._type, unpack._mem_layout);
+    }
+}
 
-    // Make sure we're unpacking the right type of data
-    SRTensorType reply_type = GetTensorCommand::get_data_type(reply);
-    if (type != reply_type)
-        throw SRRuntimeException("The type of the fetched tensor "\
-                                 "does not match the provided type");
-
-    // Retrieve the tensor data into a Tensor
-    std::string_view blob = GetTensorCommand::get_data_blob(reply);
-    TensorBase* tensor = NULL;
-    try {
-        switch (reply_type) {
-            case SRTensorTypeDouble:
-                tensor = new Tensor<double>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeFloat:
-                tensor = new Tensor<float>(get_key, (void*)blob.data(),
-                                           reply_dims, reply_type,
-                                           SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt64:
-                tensor = new Tensor<int64_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt32:
-                tensor = new Tensor<int32_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt16:
-                tensor = new Tensor<int16_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeInt8:
-                tensor = new Tensor<int8_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeUint16:
-                tensor = new Tensor<uint16_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            case SRTensorTypeUint8:
-                tensor = new Tensor<uint8_t>(get_key, (void*)blob.data(),
-                                            reply_dims, reply_type,
-                                            SRMemLayoutContiguous);
-                break;
-            default:
-                throw SRTypeException("Invalid type for unpack_tensor");
-        }
+// Get the data of multiple tensors and fill already allocated memory spaces.
+// All of the tensors are fetched with pipelined commands.
+void Client::unpack_tensors(const std::vector<std::string>& keys,
+                            const std::vector<void*>& data,
+                            const std::vector<std::vector<size_t>>& dims,
+                            const std::vector<SRTensorType>& types,
+                            const std::vector<SRMemoryLayout>& mem_layouts)
+{
+    // Make sure every destination is fully described
+    size_t n_tensors = keys.size();
+    if (data.size() != n_tensors || dims.size() != n_tensors ||
+        types.size() != n_tensors || mem_layouts.size() != n_tensors) {
+        throw SRParameterException("differing size vectors "\
+                                   "passed to unpack_tensors");
     }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("tensor");
+
+    // Validate the destinations before going to the database
+    std::vector<std::string> get_keys;
+    for (size_t i = 0; i < n_tensors; i++) {
+        _check_unpack_dims(dims[i], mem_layouts[i]);
+        get_keys.push_back(_build_tensor_key(keys[i], true));
     }
 
-    // Unpack the tensor and reclaim it
-    tensor->fill_mem_space(data, dims, mem_layout);
-    delete tensor;
-    tensor = NULL;
+    // Fetch all of the tensors and unpack them
+    std::vector<CommandReply> replies = _get_tensor_replies(get_keys);
+    for (size_t i = 0; i < n_tensors; i++) {
+        _unpack_tensor_reply(get_keys[i], replies[i], data[i], dims[i],
+                             types[i], mem_layouts[i]);
+    }
 }
 
 // Move a tensor from one key to another key
@@ -412,6 +666,8 @@ void Client::rename_tensor(const std::string& key,
     std::string p_key = _build_tensor_key(key, true);
     std::string p_new_key = _build_tensor_key(new_key, false);
     CommandReply reply = _redis_server->rename_tensor(p_key, p_new_key);
+    _invalidate_cached(p_key);
+    _invalidate_cached(p_new_key);
     if (reply.has_error())
         throw SRRuntimeException("rename_tensor failed");
 }
@@ -421,6 +677,7 @@ void Client::delete_tensor(const std::string& key)
 {
     std::string p_key = _build_tensor_key(key, true);
     CommandReply reply = _redis_server->delete_tensor(p_key);
+    _invalidate_cached(p_key);
     if (reply.has_error())
         throw SRRuntimeException("delete_tensor failed");
 }
@@ -432,6 +689,7 @@ void Client::copy_tensor(const std::string& src_key,
     std::string p_src_key = _build_tensor_key(src_key, true);
     std::string p_dest_key = _build_tensor_key(dest_key, false);
     CommandReply reply = _redis_server->copy_tensor(p_src_key, p_dest_key);
+    _invalidate_cached(p_dest_key);
     if (reply.has_error())
         throw SRRuntimeException("copy_tensor failed");
 }
@@ -515,21 +773,27 @@ void Client::set_model(const std::string& key,
     _redis_server->set_model(p_key, model, backend, device,
                              batch_size, min_batch_size,
                              tag, inputs, outputs);
+    _invalidate_cached_model_script(p_key);
 }
 
 // Retrieve the model from the database
 std::string_view Client::get_model(const std::string& key)
 {
     std::string get_key = _build_model_key(key, true);
-    CommandReply reply = _redis_server->get_model(get_key);
-    if (reply.has_error())
+    std::shared_ptr<CommandReply> reply =
+        _get_cached_model_script(get_key, "AI.MODELGET", "BLOB");
+    if (reply == nullptr) {
+        reply = std::make_shared<CommandReply>(
+            _redis_server->get_model(get_key));
+    }
+    if (reply->has_error())
         throw SRRuntimeException("failed to get model from server");
 
-    char* model = _model_queries.allocate(reply.str_len());
+    char* model = _model_queries.allocate(reply->str_len());
     if (model == NULL)
         throw SRBadAllocException("model query");
-    std::memcpy(model, reply.str(), reply.str_len());
-    return std::string_view(model, reply.str_len());
+    std::memcpy(model, reply->str(), reply->str_len());
+    return std::string_view(model, reply->str_len());
 }
 
 // Set a script from file in the database for future execution
@@ -565,18 +829,24 @@ void Client::set_script(const std::string& key,
 
     std::string s_key = _build_model_key(key, false);
     _redis_server->set_script(s_key, device, script);
+    _invalidate_cached_model_script(s_key);
 }
 
 // Retrieve the script from the database
 std::string_view Client::get_script(const std::string& key)
 {
     std::string get_key = _build_model_key(key, true);
-    CommandReply reply = _redis_server->get_script(get_key);
-    char* script = _model_queries.allocate(reply.str_len());
+    std::shared_ptr<CommandReply> reply =
+        _get_cached_model_script(get_key, "AI.SCRIPTGET", "SOURCE");
+    if (reply == nullptr) {
+        reply = std::make_shared<CommandReply>(
+            _redis_server->get_script(get_key));
+    }
+    char* script = _model_queries.allocate(reply->str_len());
     if (script == NULL)
         throw SRBadAllocException("model query");
-    std::memcpy(script, reply.str(), reply.str_len());
-    return std::string_view(script, reply.str_len());
+    std::memcpy(script, reply->str(), reply->str_len());
+    return std::string_view(script, reply->str_len());
 }
 
 // Run a model in the database using the specificed input and output tensors
@@ -591,6 +861,8 @@ void Client::run_model(const std::string& key,
         _append_with_put_prefix(outputs);
     }
     _redis_server->run_model(get_key, inputs, outputs);
+    for (size_t i = 0; i < outputs.size(); i++)
+        _invalidate_cached(outputs[i]);
 }
 
 // Run a script function in the database using the specificed input and output tensors
@@ -606,6 +878,8 @@ void Client::run_script(const std::string& key,
         _append_with_put_prefix(outputs);
     }
     _redis_server->run_script(get_key, function, inputs, outputs);
+    for (size_t i = 0; i < outputs.size(); i++)
+        _invalidate_cached(outputs[i]);
 }
 
 // Check if the key exists in the database
@@ -683,16 +957,47 @@ bool Client::poll_tensor(const std::string& name,
     return false;
 }
 
-// Check if the dataset exists in the database at a specified frequency for a specified number of times
+// Check if the dataset exists in the database at a specified frequency for a specified number of times.
+// Rather than sleeping between checks, the client blocks on the dataset ready signal on the
+// server so that it is woken as soon as the dataset is acknowledged.
 bool Client::poll_dataset(const std::string& name,
                           int poll_frequency_ms,
                           int num_tries)
 {
+    // A blocking timeout of zero would wait forever, so very
+    // short intervals fall back to sleeping between checks
+    if (poll_frequency_ms <= 0) {
+        for (int i = 0; i < num_tries; i++) {
+            if (dataset_exists(name))
+                return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(poll_frequency_ms));
+        }
+        return false;
+    }
+
+    // BRPOPLPUSH with the same source and destination leaves the
+    // signal in place, so every waiting client is woken by it.
+    // Fractional timeouts are accepted from Redis 6.0 on.
+    std::string ready_key = _build_dataset_ready_key(name, true);
+    SingleKeyCommand cmd;
+    cmd.add_field("BRPOPLPUSH");
+    cmd.add_field(ready_key, true);
+    cmd.add_field(ready_key, true);
+    cmd.add_field(std::to_string(poll_frequency_ms / 1000.0));
+
     // Check for the dataset however many times requested
     for (int i = 0; i < num_tries; i++) {
         if (dataset_exists(name))
             return true;
-        std::this_thread::sleep_for(std::chrono::milliseconds(poll_frequency_ms));
+        if (i == num_tries - 1)
+            break;
+
+        // A signal without an acknowledged dataset (e.g. one left
+        // over from an interrupted delete) would otherwise return
+        // immediately on every try
+        CommandReply reply = _run(cmd);
+        if (reply.redis_reply_type() != "REDIS_REPLY_NIL")
+            std::this_thread::sleep_for(std::chrono::milliseconds(poll_frequency_ms));
     }
 
     // If we get here, it was never found
@@ -748,6 +1053,42 @@ void Client::use_tensor_ensemble_prefix(bool use_prefix)
     _use_tensor_prefix = use_prefix;
 }
 
+// Control whether tensors, models and scripts that are read
+// are kept in a client side cache
+void Client::use_read_cache(size_t max_bytes)
+{
+    if (_read_cache != NULL) {
+        delete _read_cache;
+        _read_cache = NULL;
+    }
+    if (max_bytes == 0)
+        return;
+
+    try {
+        _read_cache = new ReadCache(max_bytes);
+    }
+    catch (std::bad_alloc& e) {
+        throw SRBadAllocException("read cache");
+    }
+}
+
+// Control whether tensors that are read are shared with the other
+// processes of the compute node
+void Client::use_shared_tensor_cache(bool use_cache)
+{
+    // The cache is kept once created, so that the data returned by
+    // get_shared_tensor() remain valid until the client is destroyed
+    if (use_cache && _shared_tensors == NULL) {
+        try {
+            _shared_tensors = new SharedTensorCache();
+        }
+        catch (std::bad_alloc& e) {
+            throw SRBadAllocException("shared tensor cache");
+        }
+    }
+    _use_shared_tensors = use_cache;
+}
+
 // Returns information about the given database node
 parsed_reply_nested_map Client::get_db_node_info(std::string address)
 {
@@ -843,7 +1184,7 @@ void Client::flush_db(std::string address)
     AddressAtCommand cmd;
     std::string host = cmd.parse_host(address);
     uint64_t port = cmd.parse_port(address);
-    if (host.empty() or port == 0){
+    if (host.empty() or (port == 0 and !cmd.is_unix_socket(address))){
         throw SRRuntimeException(std::string(address) +
                                  "is not a valid database node address.");
     }
@@ -852,6 +1193,10 @@ void Client::flush_db(std::string address)
     cmd.add_field("FLUSHDB");
 
     CommandReply reply = _run(cmd);
+    if (_read_cache != NULL)
+        _read_cache->clear();
+    if (_use_shared_tensors)
+        _shared_tensors->invalidate_all();
     if (reply.has_error() > 0)
         throw SRRuntimeException("FLUSHDB command failed");
 }
@@ -917,6 +1262,159 @@ void Client::save(std::string address)
         throw SRRuntimeException("SAVE command failed");
 }
 
+// Asynchronously put a tensor into the database. The tensor data are
+// copied before this method returns, so the caller may reuse the buffer
+// immediately.
+std::future<void> Client::put_tensor_async(const std::string& key,
+                                           void* data,
+                                           const std::vector<size_t>& dims,
+                                           const SRTensorType type,
+                                           const SRMemoryLayout mem_layout)
+{
+    std::string p_key = _build_tensor_key(key, false);
+    std::shared_ptr<TensorPack> tensors = std::make_shared<TensorPack>();
+    tensors->add_tensor(p_key, data, dims, type, mem_layout);
+
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [this, tensors]() {
+            TensorBase* tensor = *(tensors->tensor_begin());
+            CommandReply reply = _redis_server->put_tensor(*tensor);
+            _invalidate_cached(tensor->name());
+            if (reply.has_error())
+                throw SRRuntimeException("put_tensor_async failed");
+        });
+    return _submit_async(task);
+}
+
+// Asynchronously fill an already allocated memory space with tensor data.
+// The memory space must remain valid until the returned future is ready.
+std::future<void> Client::unpack_tensor_async(const std::string& key,
+                                              void* data,
+                                              const std::vector<size_t>& dims,
+                                              const SRTensorType type,
+                                              const SRMemoryLayout mem_layout)
+{
+    _check_unpack_dims(dims, mem_layout);
+
+    std::string get_key = _build_tensor_key(key, true);
+    std::vector<size_t> dims_copy(dims);
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [this, get_key, data, dims_copy, type, mem_layout]() {
+            TensorBlobSink sink(data, dims_copy, type, mem_layout);
+            CommandReply reply = _redis_server->get_tensor(get_key, sink);
+            if (!sink.filled()) {
+                _unpack_tensor_reply(get_key, reply, data, dims_copy,
+                                     type, mem_layout);
+            }
+        });
+    return _submit_async(task);
+}
+
+// Asynchronously run a model in the database
+std::future<void> Client::run_model_async(const std::string& key,
+                                          std::vector<std::string> inputs,
+                                          std::vector<std::string> outputs)
+{
+    std::string get_key = _build_model_key(key, true);
+
+    if (_use_tensor_prefix) {
+        _append_with_get_prefix(inputs);
+        _append_with_put_prefix(outputs);
+    }
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [this, get_key, inputs, outputs]() {
+            _redis_server->run_model(get_key, inputs, outputs);
+            for (size_t i = 0; i < outputs.size(); i++)
+                _invalidate_cached(outputs[i]);
+        });
+    return _submit_async(task);
+}
+
+// Asynchronously put a DataSet object into the database. The DataSet is
+// copied before this method returns, so the caller may modify or destroy
+// it immediately.
+std::future<void> Client::put_dataset_async(DataSet& dataset)
+{
+    std::shared_ptr<DataSet> dataset_copy =
+        std::make_shared<DataSet>(dataset);
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [this, dataset_copy]() {
+            put_dataset(*dataset_copy);
+        });
+    return _submit_async(task);
+}
+
+// Asynchronously retrieve a DataSet object from the database
+std::future<DataSet> Client::get_dataset_async(const std::string& name)
+{
+    auto task = std::make_shared<std::packaged_task<DataSet()>>(
+        [this, name]() {
+            return get_dataset(name);
+        });
+    std::future<DataSet> result = task->get_future();
+    _get_async_queue().submit([task]() { (*task)(); });
+    return result;
+}
+
+// Build the command to put a tensor whose data are contiguous.  The
+// data are referenced in place, so the buffer must remain valid until
+// the command has been run.
+void Client::_build_put_tensor_command(SingleKeyCommand& cmd,
+                                       const std::string& key,
+                                       void* data,
+                                       const std::vector<size_t>& dims,
+                                       const SRTensorType type)
+{
+    TensorBase::check_inputs(data, key, dims);
+    size_t n_bytes = _add_put_tensor_fields(cmd, key, dims, type);
+    cmd.add_field_ptr((char*)data, n_bytes);
+}
+
+// Add the fields of a put tensor command that precede the tensor data
+size_t Client::_add_put_tensor_fields(SingleKeyCommand& cmd,
+                                      const std::string& key,
+                                      const std::vector<size_t>& dims,
+                                      const SRTensorType type)
+{
+    auto type_str = TENSOR_STR_MAP.find(type);
+    if (type_str == TENSOR_STR_MAP.end())
+        throw SRTypeException("Invalid type for put_tensor");
+
+    size_t n_bytes = TENSOR_TYPE_SIZE_MAP.at(type);
+    for (size_t i = 0; i < dims.size(); i++)
+        n_bytes *= dims[i];
+
+    cmd.add_field("AI.TENSORSET");
+    cmd.add_field(key, true);
+    cmd.add_field(type_str->second);
+    cmd.add_fields(dims);
+    cmd.add_field("BLOB");
+    return n_bytes;
+}
+
+// Queue a task on the asynchronous request thread
+std::future<void>
+Client::_submit_async(std::shared_ptr<std::packaged_task<void()>> task)
+{
+    std::future<void> result = task->get_future();
+    _get_async_queue().submit([task]() { (*task)(); });
+    return result;
+}
+
+// Get the asynchronous request queue, starting it on first use
+AsyncQueue& Client::_get_async_queue()
+{
+    if (_async_queue == NULL) {
+        try {
+            _async_queue = new AsyncQueue();
+        }
+        catch (std::bad_alloc& e) {
+            throw SRBadAllocException("asynchronous request queue");
+        }
+    }
+    return *_async_queue;
+}
+
 // Set the prefixes that are used for set and get methods using SSKEYIN
 // and SSKEYOUT environment variables.
 void Client::_set_prefixes_from_env()
@@ -1031,6 +1529,68 @@ inline std::string Client::_build_dataset_key(const std::string& dataset_name,
     return prefix + "{" + dataset_name + "}";
 }
 
+// Read a tensor through the read cache
+std::shared_ptr<CommandReply>
+Client::_get_cached_tensor(const std::string& get_key)
+{
+    if (_read_cache == NULL)
+        return nullptr;
+
+    GetTensorCommand cmd;
+    cmd.add_field("AI.TENSORGET");
+    cmd.add_field(get_key, true);
+    cmd.add_field("META");
+    cmd.add_field("BLOB");
+    return _read_cache->get(_redis_server->get_key_address(get_key),
+                            get_key, cmd);
+}
+
+// Read a model or script through the read cache
+std::shared_ptr<CommandReply>
+Client::_get_cached_model_script(const std::string& get_key,
+                                 const std::string& command,
+                                 const std::string& field)
+{
+    if (_read_cache == NULL)
+        return nullptr;
+
+    std::string server_key = _redis_server->get_model_script_key(get_key);
+    SingleKeyCommand cmd;
+    cmd.add_field(command);
+    cmd.add_field(server_key, true);
+    cmd.add_field(field);
+    return _read_cache->get(_redis_server->get_key_address(server_key),
+                            server_key, cmd);
+}
+
+// Read a tensor through the shared tensor cache
+inline bool Client::_get_shared_tensor(const std::string& get_key,
+                                       std::string_view& blob,
+                                       std::vector<size_t>& dims,
+                                       SRTensorType& type,
+                                       bool hand_out)
+{
+    return _use_shared_tensors &&
+           _shared_tensors->get(*_redis_server, get_key, blob,
+                                dims, type, hand_out);
+}
+
+// Remove a tensor from the caches after it was written
+inline void Client::_invalidate_cached(const std::string& key)
+{
+    if (_read_cache != NULL)
+        _read_cache->invalidate(key);
+    if (_use_shared_tensors)
+        _shared_tensors->invalidate(*_redis_server, key);
+}
+
+// Remove a model or script from the read cache after it was written
+inline void Client::_invalidate_cached_model_script(const std::string& key)
+{
+    if (_read_cache != NULL)
+        _read_cache->invalidate(_redis_server->get_model_script_key(key));
+}
+
 // Create the key for putting or getting a DataSet tensor in the database
 inline std::string
 Client::_build_dataset_tensor_key(const std::string& dataset_name,
@@ -1072,6 +1632,17 @@ Client::_build_dataset_ack_key(const std::string& dataset_name,
     return _build_dataset_meta_key(dataset_name, on_db);
 }
 
+// Create the key of the list used to signal waiters in poll_dataset()
+// that the dataset has been successfully stored.  DataSet tensor keys
+// always follow the hash tag with a '.', so the ':' separator keeps
+// the list from colliding with a tensor of any name.
+inline std::string
+Client::_build_dataset_ready_key(const std::string& dataset_name,
+                                 const bool on_db)
+{
+    return _build_dataset_key(dataset_name, on_db) + ":ready";
+}
+
 // Append the Command associated with placing DataSet metadata in
 // the database to a CommandList
 void Client::_append_dataset_metadata_commands(CommandList& cmd_list,
@@ -1134,6 +1705,27 @@ void Client::_append_dataset_ack_command(CommandList& cmd_list, DataSet& dataset
     cmd->add_field(key, true);
     cmd->add_field(_DATASET_ACK_FIELD);
     cmd->add_field("1");
+
+    _append_dataset_ready_commands(cmd_list, dataset.name);
+}
+
+// Append the Commands that wake clients waiting in poll_dataset().
+// The ready list is trimmed to a single element so that repeated
+// puts of the same DataSet do not grow it.
+void Client::_append_dataset_ready_commands(CommandList& cmd_list,
+                                            const std::string& dataset_name)
+{
+    std::string key = _build_dataset_ready_key(dataset_name, false);
+    SingleKeyCommand* push_cmd = cmd_list.add_command<SingleKeyCommand>();
+    push_cmd->add_field("LPUSH");
+    push_cmd->add_field(key, true);
+    push_cmd->add_field("1");
+
+    SingleKeyCommand* trim_cmd = cmd_list.add_command<SingleKeyCommand>();
+    trim_cmd->add_field("LTRIM");
+    trim_cmd->add_field(key, true);
+    trim_cmd->add_field("0");
+    trim_cmd->add_field("0");
 }
 
 // Put the metadata fields embedded in a CommandReply into the DataSet
@@ -1162,21 +1754,68 @@ void Client::_unpack_dataset_metadata(DataSet& dataset, CommandReply& reply)
 // for memory management in any object.
 TensorBase* Client::_get_tensorbase_obj(const std::string& name)
 {
-    // Fetch the tensor
     std::string get_key = _build_tensor_key(name, true);
+    std::string_view blob;
+    std::vector<size_t> dims;
+    SRTensorType type;
+    if (_get_shared_tensor(get_key, blob, dims, type))
+        return _get_tensorbase_obj(get_key, dims, type, blob.data());
+
+    return _fetch_tensorbase_obj(get_key);
+}
+
+// Fetch a tensor from the read cache or the database and return a
+// TensorBase object for it
+TensorBase* Client::_fetch_tensorbase_obj(const std::string& get_key)
+{
+    std::shared_ptr<CommandReply> cached = _get_cached_tensor(get_key);
+    if (cached != nullptr)
+        return _get_tensorbase_obj(get_key, *cached);
+
     CommandReply reply = _redis_server->get_tensor(get_key);
     if (reply.has_error())
         throw SRRuntimeException("tensor retrieval failed");
 
+    return _get_tensorbase_obj(get_key, reply);
+}
+
+// Run pipelined AI.TENSORGET commands for the provided tensor keys
+std::vector<CommandReply>
+Client::_get_tensor_replies(const std::vector<std::string>& get_keys)
+{
+    CommandList cmds;
+    std::vector<std::string>::const_iterator it = get_keys.cbegin();
+    for ( ; it != get_keys.cend(); it++) {
+        GetTensorCommand* cmd = cmds.add_command<GetTensorCommand>();
+        cmd->add_field("AI.TENSORGET");
+        cmd->add_field(*it, true);
+        cmd->add_field("META");
+        cmd->add_field("BLOB");
+    }
+    return _run(cmds);
+}
+
+// Build a TensorBase object from the CommandReply of an AI.TENSORGET command
+TensorBase* Client::_get_tensorbase_obj(const std::string& get_key,
+                                        CommandReply& reply)
+{
     std::vector<size_t> dims = GetTensorCommand::get_dims(reply);
+    SRTensorType type = GetTensorCommand::get_data_type(reply);
+    std::string_view blob = GetTensorCommand::get_data_blob(reply);
+    return _get_tensorbase_obj(get_key, dims, type, blob.data());
+}
+
+// Build a TensorBase object from fetched contiguous tensor data
+TensorBase* Client::_get_tensorbase_obj(const std::string& get_key,
+                                        const std::vector<size_t>& dims,
+                                        const SRTensorType type,
+                                        const void* data)
+{
     if (dims.size() <= 0)
         throw SRRuntimeException("The number of dimensions of the "\
                                  "fetched tensor are invalid: " +
                                  std::to_string(dims.size()));
 
-    SRTensorType type = GetTensorCommand::get_data_type(reply);
-    std::string_view blob = GetTensorCommand::get_data_blob(reply);
-
     for (size_t i = 0; i < dims.size(); i++) {
         if (dims[i] <= 0) {
             throw SRRuntimeException("Dimension " +
@@ -1190,35 +1829,35 @@ TensorBase* Client::_get_tensorbase_obj(const std::string& name)
     try {
         switch (type) {
             case SRTensorTypeDouble:
-                ptr = new Tensor<double>(get_key, (void*)blob.data(),
+                ptr = new Tensor<double>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             case SRTensorTypeFloat:
-                ptr = new Tensor<float>(get_key, (void*)blob.data(),
+                ptr = new Tensor<float>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             case SRTensorTypeInt64:
-                ptr = new Tensor<int64_t>(get_key, (void*)blob.data(),
+                ptr = new Tensor<int64_t>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             case SRTensorTypeInt32:
-                ptr = new Tensor<int32_t>(get_key, (void*)blob.data(),
+                ptr = new Tensor<int32_t>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             case SRTensorTypeInt16:
-                ptr = new Tensor<int16_t>(get_key, (void*)blob.data(),
+                ptr = new Tensor<int16_t>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             case SRTensorTypeInt8:
-                ptr = new Tensor<int8_t>(get_key, (void*)blob.data(),
+                ptr = new Tensor<int8_t>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             case SRTensorTypeUint16:
-                ptr = new Tensor<uint16_t>(get_key, (void*)blob.data(),
+                ptr = new Tensor<uint16_t>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             case SRTensorTypeUint8:
-                ptr = new Tensor<uint8_t>(get_key, (void*)blob.data(),
+                ptr = new Tensor<uint8_t>(get_key, (void*)data,
                                         dims, type, SRMemLayoutContiguous);
                 break;
             default :
@@ -1233,3 +1872,145 @@ TensorBase* Client::_get_tensorbase_obj(const std::string& name)
     }
     return ptr;
 }
+
+// Check that a destination memory space is described correctly for
+// unpacking a tensor
+inline void Client::_check_unpack_dims(const std::vector<size_t>& dims,
+                                       const SRMemoryLayout mem_layout)
+{
+    if (mem_layout == SRMemLayoutContiguous && dims.size() > 1) {
+        throw SRRuntimeException("The destination memory space "\
+                                 "dimension vector should only "\
+                                 "be of size one if the memory "\
+                                 "layout is contiguous.");
+    }
+}
+
+// Unpack the tensor held in a CommandReply for AI.TENSORGET into an
+// already allocated memory space, checking the provided type and
+// dimensions against the retrieved values
+void Client::_unpack_tensor_reply(const std::string& get_key,
+                                  CommandReply& reply,
+                                  void* data,
+                                  const std::vector<size_t>& dims,
+                                  const SRTensorType type,
+                                  const SRMemoryLayout mem_layout)
+{
+    std::vector<size_t> reply_dims = GetTensorCommand::get_dims(reply);
+    SRTensorType reply_type = GetTensorCommand::get_data_type(reply);
+    std::string_view blob = GetTensorCommand::get_data_blob(reply);
+    _unpack_tensor_data(get_key, reply_dims, reply_type, blob,
+                        data, dims, type, mem_layout);
+}
+
+// Unpack fetched contiguous tensor data into an already allocated memory
+// space, checking the provided type and dimensions against the fetched
+// values
+void Client::_unpack_tensor_data(const std::string& get_key,
+                                 const std::vector<size_t>& fetched_dims,
+                                 const SRTensorType fetched_type,
+                                 std::string_view blob,
+                                 void* data,
+                                 const std::vector<size_t>& dims,
+                                 const SRTensorType type,
+                                 const SRMemoryLayout mem_layout)
+{
+
+    // Make sure we have the right dims to unpack into (Contiguous case)
+    if (mem_layout == SRMemLayoutContiguous ||
+        mem_layout == SRMemLayoutFortranContiguous) {
+        size_t total_dims = 1;
+        for (size_t i = 0; i < fetched_dims.size(); i++) {
+            total_dims *= fetched_dims[i];
+        }
+        if (total_dims != dims[0] &&
+            mem_layout == SRMemLayoutContiguous) {
+            throw SRRuntimeException("The dimensions of the fetched "\
+                                     "tensor " + get_key + " do not match "\
+                                     "the length of the contiguous "\
+                                     "memory space.");
+        }
+    }
+
+    // Make sure we have the right dims to unpack into (Nested case)
+    if (mem_layout == SRMemLayoutNested ||
+        mem_layout == SRMemLayoutFortranNested) {
+        if (dims.size() != fetched_dims.size()) {
+            // Same number of dimensions
+            throw SRRuntimeException("The number of dimensions of the "\
+                                     "fetched tensor " + get_key + ", " +
+                                     std::to_string(fetched_dims.size()) +
+                                     " does not match the number of "\
+                                     "dimensions of the user memory space, " +
+                                     std::to_string(dims.size()));
+        }
+
+        // Same size in each dimension
+        for (size_t i = 0; i < fetched_dims.size(); i++) {
+            if (dims[i] != fetched_dims[i]) {
+                throw SRRuntimeException("The dimensions of the fetched "\
+                                         "tensor " + get_key + " do not "\
+                                         "match the provided dimensions "\
+                                         "of the user memory space.");
+            }
+        }
+    }
+
+    // Make sure we're unpacking the right type of data
+    if (type != fetched_type)
+        throw SRRuntimeException("The type of the fetched tensor " +
+                                 get_key + " does not match the "\
+                                 "provided type");
+
+    // Make sure the fetched data hold all of the tensor data
+    auto type_size = TENSOR_TYPE_SIZE_MAP.find(fetched_type);
+    if (type_size == TENSOR_TYPE_SIZE_MAP.end())
+        throw SRTypeException("Invalid type for unpack_tensor");
+    size_t n_bytes = type_size->second;
+    for (size_t i = 0; i < fetched_dims.size(); i++)
+        n_bytes *= fetched_dims[i];
+    if (blob.size() != n_bytes) {
+        throw SRRuntimeException("The data of the fetched tensor " +
+                                 get_key + " do not match its dimensions");
+    }
+
+    // Unpack the fetched data directly into the memory space
+    const void* src = blob.data();
+    switch (fetched_type) {
+        case SRTensorTypeDouble:
+            Tensor<double>::fill_mem_space(src, fetched_dims, data,
+                                           dims, mem_layout);
+            break;
+        case SRTensorTypeFloat:
+            Tensor<float>::fill_mem_space(src, fetched_dims, data,
+                                          dims, mem_layout);
+            break;
+        case SRTensorTypeInt64:
+            Tensor<int64_t>::fill_mem_space(src, fetched_dims, data,
+                                            dims, mem_layout);
+            break;
+        case SRTensorTypeInt32:
+            Tensor<int32_t>::fill_mem_space(src, fetched_dims, data,
+                                            dims, mem_layout);
+            break;
+        case SRTensorTypeInt16:
+            Tensor<int16_t>::fill_mem_space(src, fetched_dims, data,
+                                            dims, mem_layout);
+            break;
+        case SRTensorTypeInt8:
+            Tensor<int8_t>::fill_mem_space(src, fetched_dims, data,
+                                           dims, mem_layout);
+            break;
+        case SRTensorTypeUint16:
+            Tensor<uint16_t>::fill_mem_space(src, fetched_dims, data,
+                                             dims, mem_layout);
+            break;
+        case SRTensorTypeUint8:
+            Tensor<uint8_t>::fill_mem_space(src, fetched_dims, data,
+                                            dims, mem_layout);
+            break;
+        default:
+            throw SRTypeException("Invalid type for unpack_tensor");
+    }
+}
+
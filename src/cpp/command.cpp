@@ -46,39 +46,29 @@ Command& Command::operator=(const Command& cmd)
 
     make_empty();
 
-    _fields.resize(cmd._fields.size());
-
-    // copy pointer fields and put into _fields
-    _ptr_fields = cmd._ptr_fields;
-    std::vector<std::pair<char*, size_t> >::const_iterator ptr_it =
-        _ptr_fields.begin();
-    for (; ptr_it != _ptr_fields.end(); ptr_it++)
-        _fields[ptr_it->second] = ptr_it->first;
+    // Copy all of the local fields into a single block of the
+    // arena, and keep the pointer fields pointing at user memory
+    size_t local_bytes = 0;
+    std::vector<std::string_view>::const_iterator it = cmd._fields.cbegin();
+    for ( ; it != cmd._fields.cend(); it++) {
+        if (cmd._arena.contains(it->data()))
+            local_bytes += it->size() + 1;
+    }
+    _arena.reserve(local_bytes);
 
-    // copy _local_fields and _cmd_keys, and put the fields into _fields
-    std::vector<std::pair<char*, size_t> >::const_iterator local_it =
-        cmd._local_fields.begin();
-    for (; local_it != cmd._local_fields.end(); local_it++) {
-        // allocate memory and copy a local field
-        size_t field_size = cmd._fields[local_it->second].size();
-        char* f = NULL;
-        try {
-            f = new char[field_size];
-        }
-        catch (std::bad_alloc& e) {
-            throw SRBadAllocException("field data");
+    _fields.reserve(cmd._fields.size());
+    for (it = cmd._fields.cbegin(); it != cmd._fields.cend(); it++) {
+        if (cmd._arena.contains(it->data())) {
+            char* f = _arena.allocate(it->size() + 1);
+            std::memcpy(f, it->data(), it->size());
+            f[it->size()] = '\0';
+            _fields.push_back(std::string_view(f, it->size()));
         }
-        std::memcpy(f, local_it->first, field_size);
-        _local_fields.push_back(
-            std::pair<char*, size_t>(f, local_it->second));
-        _fields[local_it->second] = std::string_view(f, field_size);
-
-        if (cmd._cmd_keys.count(cmd._fields[local_it->second]) != 0) {
-            // copy a command key
-            _cmd_keys[std::string_view(f, field_size)] =
-                local_it->second;
+        else {
+            _fields.push_back(*it);
         }
     }
+    _key_indices = cmd._key_indices;
 
     return *this;
 }
@@ -92,59 +82,21 @@ Command::~Command()
 // Add a field to the Command from a string.
 void Command::add_field(std::string field, bool is_key)
 {
-    /* Copy the field string into a char* that is stored
-    locally in the Command object.  The new string is not
-    null terminated because the fields vector is of type
-    string_view which stores the length of the string.
-    If is_key is true, the key will be added to the command
-    keys.
+    /* Copy the field string into the Command arena.
+    If is_key is true, the key will be added to the
+    command keys.
     */
-
-    size_t field_size = field.size();
-    char* f = NULL;
-    try {
-        f = (char*)new unsigned char[field_size + 1];
-    }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("field");
-    }
-
-    field.copy(f, field_size, 0);
-    f[field_size] = '\0';
-    _local_fields.push_back({f, _fields.size()});
-    _fields.push_back(std::string_view(f, field_size));
-
-    if (is_key) {
-        _cmd_keys[std::string_view(f, field_size)] = _fields.size() - 1;
-    }
+    _add_local_field(field.data(), field.size(), is_key);
 }
 
 // Add a field to the Command from a c-string.
 void Command::add_field(const char* field, bool is_key)
 {
-    /* Copy the field char* into a char* that is stored
-    locally in the Command object.  The new string is not
-    null terminated because the fields vector is of type
-    string_view which stores the length of the string.
-    If is_key is true, the key will be added to the command
-    keys.
+    /* Copy the field char* into the Command arena.
+    If is_key is true, the key will be added to the
+    command keys.
     */
-
-    size_t field_size = std::strlen(field);
-    char* f = NULL;
-    try {
-        f = new char[field_size];
-    }
-    catch (std::bad_alloc& e) {
-        throw SRBadAllocException("field");
-    }
-    std::memcpy(f, field, field_size);
-    _local_fields.push_back({f, _fields.size()});
-    _fields.push_back(std::string_view(f, field_size));
-
-    if (is_key) {
-        _cmd_keys[std::string_view(f, field_size)] = _fields.size() - 1;
-    }
+    _add_local_field(field, std::strlen(field), is_key);
 }
 
 // Add a field to the Command from a c-string without copying the data.
@@ -156,7 +108,8 @@ void Command::add_field_ptr(char* field, size_t field_size)
     accessed.  This function should be used for very large
     fields.  Field pointers cannot act as Command keys.
     */
-    _ptr_fields.push_back({field, _fields.size()});
+    if (_fields.capacity() == 0)
+        _fields.reserve(_INITIAL_FIELD_CAPACITY);
     _fields.push_back(std::string_view(field, field_size));
 }
 
@@ -170,10 +123,26 @@ void Command::add_field_ptr(std::string_view field)
     fields.  If is_key is true, the key will be added to the
     command keys.  Field pointers cannot act as Command keys.
     */
-    _ptr_fields.push_back({const_cast<char*>(field.data()), _fields.size()});
+    if (_fields.capacity() == 0)
+        _fields.reserve(_INITIAL_FIELD_CAPACITY);
     _fields.push_back(field);
 }
 
+// Replace a field of the Command with a pointer to other data
+void Command::set_field_ptr(size_t index, std::string_view field)
+{
+    if (index >= _fields.size()) {
+        throw SRRuntimeException("Field index " + std::to_string(index) +
+                                 " is out of range for the Command.");
+    }
+    std::vector<size_t>::const_iterator it = _key_indices.cbegin();
+    for ( ; it != _key_indices.cend(); it++) {
+        if (*it == index)
+            throw SRRuntimeException("A Command key cannot be replaced.");
+    }
+    _fields[index] = field;
+}
+
 // Add fields to the Command from a vector of strings.
 void Command::add_fields(const std::vector<std::string>& fields, bool is_key)
 {
@@ -230,7 +199,7 @@ Command::const_iterator Command::cend() const
 // Return true if the Command has keys
 bool Command::has_keys()
 {
-    return (_cmd_keys.size()>0);
+    return (_key_indices.size()>0);
 }
 
 // Return a copy of all Command keys
@@ -242,10 +211,10 @@ std::vector<std::string> Command::get_keys() {
     may need to grow or decrease in size.
     */
     std::vector<std::string> keys;
-    std::unordered_map<std::string_view,size_t>::iterator it =
-        _cmd_keys.begin();
-    for ( ; it != _cmd_keys.end(); it++) {
-        keys.push_back(std::string(it->first.data(), it->first.length()));
+    std::vector<size_t>::iterator it = _key_indices.begin();
+    for ( ; it != _key_indices.end(); it++) {
+        std::string_view key = _fields[*it];
+        keys.push_back(std::string(key.data(), key.length()));
     }
     return keys;
 }
@@ -253,16 +222,40 @@ std::vector<std::string> Command::get_keys() {
 // Helper function for emptying the Command
 void Command::make_empty()
 {
-    std::vector<std::pair<char*, size_t> >::iterator it =
-        _local_fields.begin();
+    _key_indices.clear();
+    _fields.clear();
+    _arena.clear();
+}
+
+// Copy a field into the Command arena and add it to the Command
+void Command::_add_local_field(const char* field,
+                               size_t field_size,
+                               bool is_key)
+{
+    /* The copy is null terminated so that the field can
+    be used as a c-string, although the fields vector is
+    of type string_view which stores the length of the
+    string.
+    */
+    char* f = _arena.allocate(field_size + 1);
+    std::memcpy(f, field, field_size);
+    f[field_size] = '\0';
+
+    if (_fields.capacity() == 0)
+        _fields.reserve(_INITIAL_FIELD_CAPACITY);
+    _fields.push_back(std::string_view(f, field_size));
+
+    if (is_key)
+        _add_key_index(_fields.size() - 1);
+}
 
-    for ( ; it != _local_fields.end(); it++) {
-        if (it->first != NULL)
-            delete(it->first);
-        *it = {NULL, 0};
+// Record a field as a Command key if it has not already been recorded
+void Command::_add_key_index(size_t index)
+{
+    std::vector<size_t>::const_iterator it = _key_indices.cbegin();
+    for ( ; it != _key_indices.cend(); it++) {
+        if (_fields[*it] == _fields[index])
+            return;
     }
-    _local_fields.clear();
-    _ptr_fields.clear();
-    _cmd_keys.clear();
-    _fields.clear();
+    _key_indices.push_back(index);
 }
@@ -0,0 +1,132 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <new>
+#include <algorithm>
+#include <functional>
+#include "fieldarena.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+// FieldArena move constructor
+FieldArena::FieldArena(FieldArena&& arena)
+{
+    _head = arena._head;
+    _used = arena._used;
+    arena._head = NULL;
+    arena._used = 0;
+}
+
+// FieldArena move assignment operator
+FieldArena& FieldArena::operator=(FieldArena&& arena)
+{
+    if (this != &arena) {
+        clear();
+        _head = arena._head;
+        _used = arena._used;
+        arena._head = NULL;
+        arena._used = 0;
+    }
+    return *this;
+}
+
+// FieldArena destructor
+FieldArena::~FieldArena()
+{
+    clear();
+}
+
+// Allocate memory from the arena
+char* FieldArena::allocate(size_t n_bytes)
+{
+    reserve(n_bytes);
+    char* ptr = _block_data(_head) + _used;
+    _used += n_bytes;
+    return ptr;
+}
+
+// Make sure that the next n_bytes of allocations fit in one block
+void FieldArena::reserve(size_t n_bytes)
+{
+    if (_head == NULL || _used + n_bytes > _head->capacity)
+        _add_block(n_bytes);
+}
+
+// Check whether memory was allocated from the arena
+bool FieldArena::contains(const char* ptr) const
+{
+    std::less<const char*> less;
+    for (Block* block = _head; block != NULL; block = block->next) {
+        const char* start = _block_data(block);
+        if (!less(ptr, start) && less(ptr, start + block->capacity))
+            return true;
+    }
+    return false;
+}
+
+// Release all of the memory of the arena
+void FieldArena::clear()
+{
+    while (_head != NULL) {
+        Block* next = _head->next;
+        delete[] reinterpret_cast<unsigned char*>(_head);
+        _head = next;
+    }
+    _used = 0;
+}
+
+// Add a block with room for at least n_bytes
+void FieldArena::_add_block(size_t n_bytes)
+{
+    // Each block is at least double the size of the previous one
+    // so that the number of blocks grows logarithmically
+    size_t capacity = _FIRST_BLOCK_SIZE;
+    if (_head != NULL)
+        capacity = 2 * _head->capacity;
+    capacity = std::max(capacity, n_bytes);
+
+    unsigned char* mem = NULL;
+    try {
+        mem = new unsigned char[sizeof(Block) + capacity];
+    }
+    catch (std::bad_alloc& e) {
+        throw SRBadAllocException("field arena");
+    }
+    Block* block = reinterpret_cast<Block*>(mem);
+    block->next = _head;
+    block->capacity = capacity;
+    _head = block;
+    _used = 0;
+}
+
+// Get the memory of a block
+inline char* FieldArena::_block_data(Block* block)
+{
+    return reinterpret_cast<char*>(block) + sizeof(Block);
+}
@@ -0,0 +1,99 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sw/redis++/redis++.h>
+#include "rawconnectionpool.h"
+
+using namespace SmartRedis;
+
+// RawConnectionPool destructor
+RawConnectionPool::~RawConnectionPool()
+{
+    for (auto it = _idle.begin(); it != _idle.end(); it++) {
+        for (size_t i = 0; i < it->second.size(); i++)
+            redisFree(it->second[i]);
+    }
+    _idle.clear();
+}
+
+// Take a connection to a database node from the pool
+redisContext* RawConnectionPool::acquire(const std::string& address)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _idle.find(address);
+        if (it != _idle.end() && it->second.size() > 0) {
+            redisContext* context = it->second.back();
+            it->second.pop_back();
+            return context;
+        }
+    }
+
+    redisContext* context = connect(address);
+    if (context == NULL) {
+        throw sw::redis::IoError("Failed to connect to the database "\
+                                 "node at " + address);
+    }
+    return context;
+}
+
+// Give a connection back to the pool
+void RawConnectionPool::release(const std::string& address,
+                                redisContext* context)
+{
+    if (context == NULL)
+        return;
+    if (context->err != 0) {
+        redisFree(context);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _idle[address].push_back(context);
+}
+
+// Open a hiredis connection to a database node
+redisContext* RawConnectionPool::connect(const std::string& address)
+{
+    redisContext* context = NULL;
+    if (address.size() > 0 && address[0] == '/') {
+        context = redisConnectUnix(address.c_str());
+    }
+    else {
+        size_t colon = address.rfind(':');
+        if (colon == std::string::npos)
+            return NULL;
+        int port = std::atoi(address.c_str() + colon + 1);
+        context = redisConnect(address.substr(0, colon).c_str(), port);
+    }
+
+    if (context != NULL && context->err != 0) {
+        redisFree(context);
+        context = NULL;
+    }
+    return context;
+}
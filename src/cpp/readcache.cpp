@@ -0,0 +1,328 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <sys/socket.h>
+#include <vector>
+#include "readcache.h"
+#include "rawconnectionpool.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+// ReadCache constructor
+ReadCache::ReadCache(size_t max_bytes)
+    : _max_bytes(max_bytes), _n_bytes(0), _epoch(0)
+{
+    if (max_bytes == 0)
+        throw SRParameterException("The memory budget of the read "\
+                                   "cache must be greater than 0.");
+}
+
+// ReadCache destructor
+ReadCache::~ReadCache()
+{
+    std::lock_guard<std::mutex> lock(_nodes_mutex);
+    for (auto it = _nodes.begin(); it != _nodes.end(); it++)
+        _close_node(*(it->second));
+    _nodes.clear();
+}
+
+// Get the reply of a read command on a key, running the command
+// on a tracked connection if the reply is not cached
+std::shared_ptr<CommandReply> ReadCache::get(const std::string& address,
+                                             const std::string& key,
+                                             const Command& cmd)
+{
+    uint64_t epoch = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            _lru.splice(_lru.begin(), _lru, it->second);
+            return it->second->reply;
+        }
+        _n_pending[key]++;
+        epoch = _epoch;
+    }
+
+    // The command is run without holding the lock so that
+    // invalidations can be recorded while it is in flight
+    redisReply* raw = _fetch(address, cmd);
+    bool cacheable = raw != NULL &&
+                     raw->type != REDIS_REPLY_ERROR &&
+                     raw->type != REDIS_REPLY_NIL;
+    std::shared_ptr<CommandReply> reply;
+    size_t n_bytes = 0;
+    if (cacheable) {
+        n_bytes = _reply_bytes(raw);
+        reply = std::make_shared<CommandReply>(
+            RedisReplyUPtr(raw, sw::redis::ReplyDeleter()));
+    }
+    else {
+        freeReplyObject(raw);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    bool stale = _stale.count(key) > 0;
+    if (--_n_pending[key] == 0) {
+        _n_pending.erase(key);
+        _stale.erase(key);
+    }
+    if (cacheable && !stale && epoch == _epoch)
+        _insert(key, reply, n_bytes);
+    return reply;
+}
+
+// Remove a key from the cache
+void ReadCache::invalidate(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        _n_bytes -= it->second->n_bytes;
+        _lru.erase(it->second);
+        _entries.erase(it);
+    }
+    if (_n_pending.count(key) > 0)
+        _stale.insert(key);
+}
+
+// Remove every key from the cache
+void ReadCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _clear();
+}
+
+// Get the number of bytes held by cached replies
+size_t ReadCache::n_bytes()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _n_bytes;
+}
+
+// Get the number of cached replies
+size_t ReadCache::n_entries()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+// Insert a reply at the front of the LRU order and evict the least
+// recently used replies until the memory budget is met
+void ReadCache::_insert(const std::string& key,
+                        std::shared_ptr<CommandReply> reply,
+                        size_t n_bytes)
+{
+    if (n_bytes > _max_bytes)
+        return;
+
+    // Another read of the key may have been cached in the meantime
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        _n_bytes -= it->second->n_bytes;
+        _lru.erase(it->second);
+        _entries.erase(it);
+    }
+
+    _lru.push_front(CacheEntry{key, reply, n_bytes});
+    _entries[key] = _lru.begin();
+    _n_bytes += n_bytes;
+
+    while (_n_bytes > _max_bytes) {
+        CacheEntry& oldest = _lru.back();
+        _n_bytes -= oldest.n_bytes;
+        _entries.erase(oldest.key);
+        _lru.pop_back();
+    }
+}
+
+// Remove every key from the cache
+void ReadCache::_clear()
+{
+    _lru.clear();
+    _entries.clear();
+    _n_bytes = 0;
+    _epoch++;
+}
+
+// Run a command on the tracked connection of a node
+redisReply* ReadCache::_fetch(const std::string& address, const Command& cmd)
+{
+    std::shared_ptr<TrackedNode> node = _get_node(address);
+    if (node == nullptr)
+        return NULL;
+
+    std::vector<const char*> argv;
+    std::vector<size_t> argv_len;
+    for (auto it = cmd.cbegin(); it != cmd.cend(); it++) {
+        argv.push_back(it->data());
+        argv_len.push_back(it->size());
+    }
+
+    std::lock_guard<std::mutex> lock(node->data_mutex);
+    if (!node->alive || node->data == NULL)
+        return NULL;
+    redisReply* reply = (redisReply*)redisCommandArgv(node->data,
+                                                      (int)argv.size(),
+                                                      argv.data(),
+                                                      argv_len.data());
+    if (reply == NULL) {
+        // Tracking ends with the data connection.  Closing the
+        // listener stops its thread, which clears the cache.
+        node->alive = false;
+        if (node->listener != NULL)
+            ::shutdown(node->listener->fd, SHUT_RDWR);
+    }
+    return reply;
+}
+
+// Get the tracked connections of a node, opening them if needed
+std::shared_ptr<ReadCache::TrackedNode>
+ReadCache::_get_node(const std::string& address)
+{
+    std::lock_guard<std::mutex> lock(_nodes_mutex);
+    auto it = _nodes.find(address);
+    if (it != _nodes.end()) {
+        if (it->second->alive)
+            return it->second;
+        _close_node(*(it->second));
+        _nodes.erase(it);
+    }
+
+    std::shared_ptr<TrackedNode> node = std::make_shared<TrackedNode>();
+    if (!_open_node(*node, address)) {
+        _close_node(*node);
+        return nullptr;
+    }
+    _nodes[address] = node;
+    return node;
+}
+
+// Open the tracked connections of a node and start the thread
+// that reads its announcements
+bool ReadCache::_open_node(TrackedNode& node, const std::string& address)
+{
+    node.listener = RawConnectionPool::connect(address);
+    node.data = RawConnectionPool::connect(address);
+    if (node.listener == NULL || node.data == NULL)
+        return false;
+
+    // The announcements are redirected to the listener by its ID
+    redisReply* reply = (redisReply*)redisCommand(node.listener, "CLIENT ID");
+    if (reply == NULL || reply->type != REDIS_REPLY_INTEGER) {
+        freeReplyObject(reply);
+        return false;
+    }
+    long long listener_id = reply->integer;
+    freeReplyObject(reply);
+
+    reply = (redisReply*)redisCommand(node.listener, "SUBSCRIBE %s",
+                                      _INVALIDATE_CHANNEL.c_str());
+    bool subscribed = reply != NULL && reply->type == REDIS_REPLY_ARRAY;
+    freeReplyObject(reply);
+    if (!subscribed)
+        return false;
+
+    reply = (redisReply*)redisCommand(node.data,
+                                      "CLIENT TRACKING on REDIRECT %lld",
+                                      listener_id);
+    bool tracking = reply != NULL && reply->type == REDIS_REPLY_STATUS;
+    freeReplyObject(reply);
+    if (!tracking)
+        return false;
+
+    node.alive = true;
+    node.thread = std::thread(&ReadCache::_listen, this, &node);
+    return true;
+}
+
+// Stop the thread of a node and close its connections
+void ReadCache::_close_node(TrackedNode& node)
+{
+    // A read that fails shuts the listener down too, so the
+    // listener is only touched while holding the data mutex
+    node.alive = false;
+    {
+        std::lock_guard<std::mutex> lock(node.data_mutex);
+        if (node.listener != NULL)
+            ::shutdown(node.listener->fd, SHUT_RDWR);
+    }
+    if (node.thread.joinable())
+        node.thread.join();
+
+    std::lock_guard<std::mutex> lock(node.data_mutex);
+    if (node.listener != NULL) {
+        redisFree(node.listener);
+        node.listener = NULL;
+    }
+    if (node.data != NULL) {
+        redisFree(node.data);
+        node.data = NULL;
+    }
+}
+
+// Read invalidation announcements from the listener connection of a
+// node until the connection is closed
+void ReadCache::_listen(TrackedNode* node)
+{
+    void* raw = NULL;
+    while (redisGetReply(node->listener, &raw) == REDIS_OK) {
+        // Announcements are published as ["message", channel, keys]
+        redisReply* reply = (redisReply*)raw;
+        if (reply != NULL && reply->type == REDIS_REPLY_ARRAY &&
+            reply->elements == 3) {
+            redisReply* keys = reply->element[2];
+            if (keys->type == REDIS_REPLY_ARRAY) {
+                for (size_t i = 0; i < keys->elements; i++) {
+                    invalidate(std::string(keys->element[i]->str,
+                                           keys->element[i]->len));
+                }
+            }
+            else {
+                // A nil payload announces that the database was flushed
+                clear();
+            }
+        }
+        freeReplyObject(reply);
+        raw = NULL;
+    }
+
+    // Changes to the keys of the node can no longer be seen
+    node->alive = false;
+    clear();
+}
+
+// Estimate the number of bytes held by a reply
+size_t ReadCache::_reply_bytes(const redisReply* reply)
+{
+    size_t n_bytes = sizeof(redisReply) + reply->len;
+    for (size_t i = 0; i < reply->elements; i++)
+        n_bytes += sizeof(redisReply*) + _reply_bytes(reply->element[i]);
+    return n_bytes;
+}
@@ -60,6 +60,11 @@ CommandReply Redis::run(SingleKeyCommand& cmd){
     return _run(cmd);
 }
 
+// Run a single-key Command whose key is in a known hash slot
+CommandReply Redis::run(SingleKeyCommand& cmd, uint16_t hash_slot){
+    return _run(cmd);
+}
+
 // Run a multi-key Command on the server
 CommandReply Redis::run(MultiKeyCommand& cmd){
     return _run(cmd);
@@ -84,15 +89,25 @@ CommandReply Redis::run(AddressAnyCommand& cmd){
     return _run(cmd);
 }
 
-// Run a Command list on the server
+// Run a Command list on the server as a single pipeline
 std::vector<CommandReply> Redis::run(CommandList& cmds)
 {
-    std::vector<CommandReply> replies;
+    // Every Command goes to the same server, but an address-at
+    // Command must still address the server we are connected to
+    std::vector<Command*> pipeline;
     CommandList::iterator cmd = cmds.begin();
     for ( ; cmd != cmds.end(); cmd++) {
-        replies.push_back(dynamic_cast<Command*>(*cmd)->run_me(this));
+        AddressAtCommand* aat_cmd = dynamic_cast<AddressAtCommand*>(*cmd);
+        if (aat_cmd != NULL &&
+            !is_addressable(aat_cmd->get_address(), aat_cmd->get_port())) {
+            throw SRRuntimeException("The provided host and port do not match "\
+                                     "the host and port used to initialize the "\
+                                     "non-cluster client connection.");
+        }
+        pipeline.push_back(*cmd);
     }
-    return replies;
+
+    return _run_pipeline(*_redis, pipeline);
 }
 
 // Check if a model or script key exists in the database
@@ -140,8 +155,35 @@ bool Redis::hash_field_exists(const std::string& key,
 bool Redis::is_addressable(const std::string& address,
                            const uint64_t& port)
 {
-    return _address_node_map.find(address + ":" + std::to_string(port)) !=
-        _address_node_map.end();
+    // Unix domain sockets are addressed by path with a port of 0
+    std::string node = port == 0 ? address :
+                       address + ":" + std::to_string(port);
+    return _address_node_map.find(node) != _address_node_map.end();
+}
+
+// Check if two keys can be addressed by a single multi-key command
+bool Redis::is_colocated(const std::string& key,
+                         const std::string& other_key)
+{
+    return true;
+}
+
+// Get the hash slot of a key
+uint16_t Redis::get_hash_slot(const std::string& key)
+{
+    return 0;
+}
+
+// Get the address of the database node that holds a key
+std::string Redis::get_key_address(const std::string& key)
+{
+    return _address_node_map.begin()->first;
+}
+
+// Get the key that get_model() and get_script() read from
+std::string Redis::get_model_script_key(const std::string& key)
+{
+    return key;
 }
 
 // Put a Tensor on the server
@@ -174,6 +216,19 @@ CommandReply Redis::get_tensor(const std::string& key)
     return run(cmd);
 }
 
+// Get a Tensor from the server, writing its data into a sink
+CommandReply Redis::get_tensor(const std::string& key, TensorBlobSink& sink)
+{
+    return _get_tensor_to_sink(*_redis, key, sink);
+}
+
+// Get a Tensor whose key is in a known hash slot, writing its data into a sink
+CommandReply Redis::get_tensor(const std::string& key, TensorBlobSink& sink,
+                               uint16_t hash_slot)
+{
+    return _get_tensor_to_sink(*_redis, key, sink);
+}
+
 // Rename a tensor in the database
 CommandReply Redis::rename_tensor(const std::string& key,
                                   const std::string& new_key)
@@ -204,39 +259,13 @@ CommandReply Redis::delete_tensor(const std::string& key)
 CommandReply Redis::copy_tensor(const std::string& src_key,
                                 const std::string& dest_key)
 {
-    //TODO can we do COPY for same hash slot or database?
-
-    // Build a GET command to fetch the tensor
-    GetTensorCommand cmd_get;
-    cmd_get.add_field("AI.TENSORGET");
-    cmd_get.add_field(src_key, true);
-    cmd_get.add_field("META");
-    cmd_get.add_field("BLOB");
-
-    // Run the GET command
-    CommandReply cmd_get_reply = run(cmd_get);
-    if (cmd_get_reply.has_error() > 0) {
-        throw SRRuntimeException("Failed to retrieve tensor " +
-                                 src_key + "from database");
-    }
-
-    // Decode the tensor
-    std::vector<size_t> dims = cmd_get.get_dims(cmd_get_reply);
-    std::string_view blob = cmd_get.get_data_blob(cmd_get_reply);
-    SRTensorType type = cmd_get.get_data_type(cmd_get_reply);
-
-    // Build a PUT command to send the tensor back to the database
-    // under the new key
-    MultiKeyCommand cmd_put;
-    cmd_put.add_field("AI.TENSORSET");
-    cmd_put.add_field(dest_key, true);
-    cmd_put.add_field(TENSOR_STR_MAP.at(type));
-    cmd_put.add_fields(dims);
-    cmd_put.add_field("BLOB");
-    cmd_put.add_field_ptr(blob);
+    // Every key lives on this server, so the tensor can be duplicated
+    // without its data leaving the server
+    CompoundCommand cmd;
+    _build_server_copy(cmd, src_key, dest_key);
 
-    // Run the PUT command
-    return run(cmd_put);
+    // Run it
+    return run(cmd);
 }
 
 // Copy a vector of tensors from source keys to destination keys
@@ -249,22 +278,22 @@ CommandReply Redis::copy_tensors(const std::vector<std::string>& src,
                                  "passed to copy_tensors");
     }
 
-    // Copy tensors one at a time. We only need to check one iterator
-    // for reaching the end since we know from above that they are the
-    // same length
+    // Build a server-side copy for each tensor. We only need to check
+    // one iterator for reaching the end since we know from above that
+    // they are the same length
+    CommandList cmds;
     std::vector<std::string>::const_iterator it_src = src.cbegin();
     std::vector<std::string>::const_iterator it_dest = dest.cbegin();
-    CommandReply reply;
     for ( ; it_src != src.cend(); it_src++, it_dest++) {
-        reply = copy_tensor(*it_src, *it_dest);
-        if (reply.has_error() > 0) {
-            throw SRRuntimeException("tensor copy failed");
-        }
-
+        CompoundCommand* cmd = cmds.add_command<CompoundCommand>();
+        _build_server_copy(*cmd, *it_src, *it_dest);
     }
 
+    // Run the copies as a single pipeline
+    std::vector<CommandReply> replies = run(cmds);
+
     // Done
-    return reply;
+    return replies.size() > 0 ? std::move(replies.back()) : CommandReply();
 }
 
 // Set a model from std::string_view buffer in the database for future execution
@@ -432,7 +461,7 @@ inline CommandReply Redis::_run(const Command& cmd)
     for (int i = 1; i <= _command_attempts; i++) {
         try {
             // Run the command
-            CommandReply reply = _redis->command(cmd.cbegin(), cmd.cend());
+            CommandReply reply = _exec_command(*_redis, cmd);
             if (reply.has_error() == 0)
                 return reply;
 
@@ -511,6 +540,14 @@ inline void Redis::_connect(std::string address_port)
             // Attempt to have the sw::redis::Redis object
             // make a connection using the PING command
             if (_redis->ping().compare("PONG") == 0) {
+                // Raw connections are opened on the same address,
+                // without the URI scheme
+                std::string raw_address = address_port;
+                if (raw_address.rfind(_UNIX_SCHEME, 0) == 0)
+                    raw_address = raw_address.substr(_UNIX_SCHEME.size());
+                else if (raw_address.rfind("tcp://", 0) == 0)
+                    raw_address = raw_address.substr(6);
+                _set_raw_address(_redis, raw_address);
                 return;
             }
         }
@@ -36,13 +36,15 @@ using namespace SmartRedis;
 // RedisCluster constructor
 RedisCluster::RedisCluster() : RedisServer()
 {
-    std::string address_port = _get_ssdb();
+    _init_connections_per_node();
+    std::string address_port = _connect_local_socket(_get_ssdb());
     _connect(address_port);
     _map_cluster();
+    address_port = address_port.substr(6);
     if (_address_node_map.count(address_port) > 0)
-        _last_prefix = _address_node_map.at(address_port)->prefix;
+        _last_hash_slot = _address_node_map.at(address_port)->lower_hash_slot;
     else if (_db_nodes.size() > 0)
-        _last_prefix = _db_nodes[0].prefix;
+        _last_hash_slot = _db_nodes[0].lower_hash_slot;
     else
         throw SRRuntimeException("Cluster mapping failed in client initialization");
 }
@@ -51,12 +53,16 @@ RedisCluster::RedisCluster() : RedisServer()
 // environment variables
 RedisCluster::RedisCluster(std::string address_port) : RedisServer()
 {
+    _init_connections_per_node();
+    address_port = _connect_local_socket(address_port);
     _connect(address_port);
     _map_cluster();
+    if (address_port.rfind("tcp://", 0) == 0)
+        address_port = address_port.substr(6);
     if (_address_node_map.count(address_port) > 0)
-        _last_prefix = _address_node_map.at(address_port)->prefix;
+        _last_hash_slot = _address_node_map.at(address_port)->lower_hash_slot;
     else if (_db_nodes.size() > 0)
-        _last_prefix = _db_nodes[0].prefix;
+        _last_hash_slot = _db_nodes[0].lower_hash_slot;
     else
         throw SRRuntimeException("Cluster mapping failed in client initialization");
 }
@@ -64,6 +70,12 @@ RedisCluster::RedisCluster(std::string address_port) : RedisServer()
 // RedisCluster destructor
 RedisCluster::~RedisCluster()
 {
+    // Let a background remap finish before its connection goes away
+    {
+        std::lock_guard<std::mutex> lock(_refresh_mutex);
+        if (_refresh_future.valid())
+            _refresh_future.wait();
+    }
     if (_redis_cluster != NULL) {
         delete _redis_cluster;
         _redis_cluster = NULL;
@@ -74,67 +86,153 @@ RedisCluster::~RedisCluster()
 CommandReply RedisCluster::run(SingleKeyCommand& cmd)
 {
     // Preprend the target database to the command
-    std::string db_prefix;
+    uint16_t hash_slot;
     if (cmd.has_keys())
-        db_prefix = _get_db_node_prefix(cmd);
+        hash_slot = _get_keys_hash_slot(cmd);
     else
         throw SRRuntimeException("Redis has failed to find database");
 
-    return _run(cmd, db_prefix);
+    return _run(cmd, hash_slot);
+}
+
+// Run a single-key Command whose key is in a known hash slot
+CommandReply RedisCluster::run(SingleKeyCommand& cmd, uint16_t hash_slot)
+{
+    return _run(cmd, hash_slot);
 }
 
 // Run a compound Command on the server
 CommandReply RedisCluster::run(CompoundCommand& cmd)
 {
-    std::string db_prefix;
+    uint16_t hash_slot;
     if (cmd.has_keys())
-        db_prefix = _get_db_node_prefix(cmd);
+        hash_slot = _get_keys_hash_slot(cmd);
     else
         throw SRRuntimeException("Redis has failed to find database");
 
-    return _run(cmd, db_prefix);
+    return _run(cmd, hash_slot);
 }
 
 // Run a MultiKeyCommand on the server
 CommandReply RedisCluster::run(MultiKeyCommand& cmd)
 {
-    std::string db_prefix;
+    uint16_t hash_slot;
     if (cmd.has_keys())
-        db_prefix = _get_db_node_prefix(cmd);
+        hash_slot = _get_keys_hash_slot(cmd);
     else
         throw SRRuntimeException("Redis has failed to find database");
 
-    return _run(cmd, db_prefix);
+    return _run(cmd, hash_slot);
 }
 
 // Run a non-keyed Command that addresses the given db node on the server
 CommandReply RedisCluster::run(AddressAtCommand& cmd)
 {
-    std::string db_prefix;
+    uint16_t hash_slot;
     if (is_addressable(cmd.get_address(), cmd.get_port()))
-        db_prefix = _address_node_map.at(cmd.get_address() + ":"
-                    + std::to_string(cmd.get_port()))->prefix;
+        hash_slot = _get_address_hash_slot(
+                    _get_node_address(cmd.get_address(), cmd.get_port()));
     else
         throw SRRuntimeException("Redis has failed to find database");
 
-    return _run(cmd, db_prefix);
+    return _run(cmd, hash_slot);
 }
 
 // Run a non-keyed Command that addresses any db node on the server
 CommandReply RedisCluster::run(AddressAnyCommand &cmd)
 {
-    return _run(cmd, _last_prefix);
+    return _run(cmd, _last_hash_slot);
 }
 
 // Run multiple single-key or single-hash slot Command on the server.
-// Each Command in the CommandList is run sequentially
+// The Command are grouped by target db node, each group is pipelined
+// to its db node, and all db nodes work on their groups concurrently
 std::vector<CommandReply> RedisCluster::run(CommandList& cmds)
 {
-    std::vector<CommandReply> replies;
+    // Group the Command by the db node they address, keeping track
+    // of the position of each Command in the CommandList
+    std::vector<sw::redis::Redis*> dbs;
+    std::vector<uint16_t> hash_slots;
+    std::vector<std::vector<Command*>> groups;
+    std::vector<std::vector<size_t>> positions;
+    std::unordered_map<sw::redis::Redis*, size_t> group_index;
+    size_t n_cmds = 0;
     CommandList::iterator cmd = cmds.begin();
-    for ( ; cmd != cmds.end(); cmd++) {
-        replies.push_back(dynamic_cast<Command*>(*cmd)->run_me(this));
+    for ( ; cmd != cmds.end(); cmd++, n_cmds++) {
+        uint16_t hash_slot = _get_cmd_hash_slot(*cmd);
+        sw::redis::Redis* db = _get_slot_connection(hash_slot);
+        auto it = group_index.find(db);
+        if (it == group_index.end()) {
+            it = group_index.emplace(db, dbs.size()).first;
+            dbs.push_back(db);
+            hash_slots.push_back(hash_slot);
+            groups.push_back(std::vector<Command*>());
+            positions.push_back(std::vector<size_t>());
+        }
+        groups[it->second].push_back(*cmd);
+        positions[it->second].push_back(n_cmds);
     }
+
+    // Write the pipeline of every group before reading any reply so
+    // that the db nodes work on their groups at the same time.  A group
+    // that cannot be written is run on its own with _run_group(),
+    // which remaps the cluster and retries it.
+    std::vector<redisContext*> contexts(groups.size(), NULL);
+    std::exception_ptr error = nullptr;
+    for (size_t g = 0; g < groups.size(); g++) {
+        try {
+            contexts[g] = _send_pipeline(*dbs[g], groups[g]);
+        }
+        catch (sw::redis::Error& e) {
+            contexts[g] = NULL;
+        }
+        catch (...) {
+            if (error == nullptr)
+                error = std::current_exception();
+        }
+    }
+
+    // Read the replies of every group before propagating any failure
+    // so that no connection is left with unread replies
+    std::vector<std::vector<CommandReply>> group_replies(groups.size());
+    for (size_t g = 0; g < groups.size(); g++) {
+        try {
+            bool sent = contexts[g] != NULL;
+            if (sent) {
+                redisContext* context = contexts[g];
+                contexts[g] = NULL;
+                try {
+                    group_replies[g] = _recv_pipeline(*dbs[g], context,
+                                                      groups[g].size());
+                }
+                catch (sw::redis::IoError& e) {
+                    sent = false;
+                }
+                catch (sw::redis::ClosedError& e) {
+                    sent = false;
+                }
+            }
+            if (sent)
+                _follow_redirects(group_replies[g], groups[g]);
+            else if (error == nullptr)
+                group_replies[g] = _run_group(groups[g], hash_slots[g]);
+        }
+        catch (...) {
+            if (error == nullptr)
+                error = std::current_exception();
+        }
+    }
+    if (error != nullptr)
+        std::rethrow_exception(error);
+
+    // Put the replies back in CommandList order
+    std::vector<CommandReply> replies(n_cmds);
+    for (size_t g = 0; g < groups.size(); g++) {
+        for (size_t i = 0; i < positions[g].size(); i++)
+            replies[positions[g][i]] = std::move(group_replies[g][i]);
+    }
+    if (hash_slots.size() > 0)
+        _last_hash_slot = hash_slots.back();
     return replies;
 }
 
@@ -142,10 +240,7 @@ std::vector<CommandReply> RedisCluster::run(CommandList& cmds)
 bool RedisCluster::model_key_exists(const std::string& key)
 {
     // Add model prefix to the key
-    DBNode* node = &(_db_nodes[0]);
-    if (node == NULL)
-        return false;
-    std::string prefixed_key = '{' + node->prefix + "}." + key;
+    std::string prefixed_key = '{' + _get_slot_node(0).prefix + "}." + key;
 
     // And perform key existence check
     return key_exists(prefixed_key);
@@ -190,10 +285,37 @@ bool RedisCluster::hash_field_exists(const std::string& key,
 bool RedisCluster::is_addressable(const std::string& address,
                                   const uint64_t& port)
 {
-    std::string addr = address + ":" + std::to_string(port);
+    std::string addr = _get_node_address(address, port);
+    std::shared_lock<std::shared_mutex> lock(_topology_mutex);
     return _address_node_map.find(addr) != _address_node_map.end();
 }
 
+// Check if two keys can be addressed by a single multi-key command
+bool RedisCluster::is_colocated(const std::string& key,
+                                const std::string& other_key)
+{
+    return _get_hash_slot(key) == _get_hash_slot(other_key);
+}
+
+// Get the hash slot of a key
+uint16_t RedisCluster::get_hash_slot(const std::string& key)
+{
+    return _get_hash_slot(key);
+}
+
+// Get the address of the database node that holds a key
+std::string RedisCluster::get_key_address(const std::string& key)
+{
+    DBNode node = _get_slot_node(_get_hash_slot(key));
+    return node.ip + ":" + std::to_string(node.port);
+}
+
+// Get the key that get_model() and get_script() read from
+std::string RedisCluster::get_model_script_key(const std::string& key)
+{
+    return "{" + _get_slot_node(0).prefix + "}." + key;
+}
+
 // Put a Tensor on the server
 CommandReply RedisCluster::put_tensor(TensorBase& tensor)
 {
@@ -224,6 +346,29 @@ CommandReply RedisCluster::get_tensor(const std::string& key)
     return run(cmd);
 }
 
+// Get a Tensor from the server, writing its data into a sink
+CommandReply RedisCluster::get_tensor(const std::string& key,
+                                      TensorBlobSink& sink)
+{
+    return get_tensor(key, sink, _get_hash_slot(key));
+}
+
+// Get a Tensor whose key is in a known hash slot, writing its data into a sink
+CommandReply RedisCluster::get_tensor(const std::string& key,
+                                      TensorBlobSink& sink,
+                                      uint16_t hash_slot)
+{
+    // The read goes through _run_group() so that it is redirected
+    // and retried like any other Command
+    GetTensorCommand cmd;
+    cmd.add_field("AI.TENSORGET");
+    cmd.add_field(key, true);
+    cmd.add_field("META");
+    cmd.add_field("BLOB");
+    std::vector<Command*> cmds = {&cmd};
+    return std::move(_run_group(cmds, hash_slot, &sink)[0]);
+}
+
 // Rename a tensor in the database
 CommandReply RedisCluster::rename_tensor(const std::string& key,
                                          const std::string& new_key)
@@ -271,36 +416,16 @@ CommandReply RedisCluster::delete_tensor(const std::string& key)
 CommandReply RedisCluster::copy_tensor(const std::string& src_key,
                                        const std::string& dest_key)
 {
-    //TODO can we do COPY for same hash slot or database (only for redis 6.2)?
-
-    // Build the GET command
-    GetTensorCommand cmd_get;
-    cmd_get.add_field("AI.TENSORGET");
-    cmd_get.add_field(src_key, true);
-    cmd_get.add_field("META");
-    cmd_get.add_field("BLOB");
-
-    // Run the GET command
-    CommandReply cmd_get_reply = run(cmd_get);
-    if (cmd_get_reply.has_error() > 0)
-        throw SRRuntimeException("Failed to find tensor " + src_key);
-
-    // Decode the tensor
-    std::vector<size_t> dims = cmd_get.get_dims(cmd_get_reply);
-    std::string_view blob = cmd_get.get_data_blob(cmd_get_reply);
-    SRTensorType type = cmd_get.get_data_type(cmd_get_reply);
-
-    // Build the PUT command
-    MultiKeyCommand cmd_put;
-    cmd_put.add_field("AI.TENSORSET");
-    cmd_put.add_field(dest_key, true);
-    cmd_put.add_field(TENSOR_STR_MAP.at(type));
-    cmd_put.add_fields(dims);
-    cmd_put.add_field("BLOB");
-    cmd_put.add_field_ptr(blob);
+    // Keys in the same hash slot can be copied without the tensor
+    // data leaving the server
+    if (_get_hash_slot(src_key) == _get_hash_slot(dest_key)) {
+        CompoundCommand cmd;
+        _build_server_copy(cmd, src_key, dest_key);
+        return run(cmd);
+    }
 
-    // Run the PUT command
-    return run(cmd_put);
+    // Otherwise the tensor has to be moved through the client
+    return _client_side_copy(src_key, dest_key);
 }
 
 // Copy a vector of tensors from source keys to destination keys
@@ -313,18 +438,32 @@ CommandReply RedisCluster::copy_tensors(const std::vector<std::string>& src,
                                  "passed to copy_tensors");
     }
 
-    // Copy tensors one at a time. We only need to check one iterator
-    // for reaching the end since we know from above that they are the
-    // same length
-    std::vector<std::string>::const_iterator it_src = src.cbegin();
-    std::vector<std::string>::const_iterator it_dest = dest.cbegin();
+    // Copies within a hash slot are pipelined as server-side copies
+    // and the rest are moved through the client one at a time.  The
+    // pipeline is flushed before each client-side copy so that the
+    // copies are made in the order given.
     CommandReply reply;
-    for ( ; it_src != src.cend(); it_src++, it_dest++) {
-        reply = copy_tensor(*it_src, *it_dest);
-        if (reply.has_error() > 0) {
-            throw SRRuntimeException("tensor copy failed");
+    size_t i = 0;
+    while (i < src.size()) {
+        CommandList server_cmds;
+        size_t n_server_cmds = 0;
+        for ( ; i < src.size() &&
+                _get_hash_slot(src[i]) == _get_hash_slot(dest[i]); i++) {
+            CompoundCommand* cmd = server_cmds.add_command<CompoundCommand>();
+            _build_server_copy(*cmd, src[i], dest[i]);
+            n_server_cmds++;
+        }
+        if (n_server_cmds > 0) {
+            std::vector<CommandReply> replies = run(server_cmds);
+            reply = std::move(replies.back());
         }
 
+        if (i < src.size()) {
+            reply = _client_side_copy(src[i], dest[i]);
+            if (reply.has_error() > 0)
+                throw SRRuntimeException("tensor copy failed");
+            i++;
+        }
     }
 
     // Done
@@ -342,14 +481,14 @@ CommandReply RedisCluster::set_model(const std::string& model_name,
                                      const std::vector<std::string>& inputs,
                                      const std::vector<std::string>& outputs)
 {
-    std::vector<DBNode>::const_iterator node = _db_nodes.cbegin();
-    CommandReply reply;
-    for ( ; node != _db_nodes.cend(); node++) {
+    std::vector<DBNode> db_nodes = _get_db_nodes();
+    std::vector<CompoundCommand> cmds(db_nodes.size());
+    for (size_t i = 0; i < db_nodes.size(); i++) {
         // Build the node prefix
-        std::string prefixed_key = "{" + node->prefix + "}." + model_name;
+        std::string prefixed_key = "{" + db_nodes[i].prefix + "}." + model_name;
 
         // Build the MODELSET commnd
-        CompoundCommand cmd;
+        CompoundCommand& cmd = cmds[i];
         cmd.add_field("AI.MODELSET");
         cmd.add_field(prefixed_key, true);
         cmd.add_field(backend);
@@ -378,16 +517,10 @@ CommandReply RedisCluster::set_model(const std::string& model_name,
         }
         cmd.add_field("BLOB");
         cmd.add_field_ptr(model);
-
-        // Run the command
-        reply = run(cmd);
-        if (reply.has_error() > 0) {
-            throw SRRuntimeException("SetModel failed for node " + node->name);
-        }
     }
 
-    // Done
-    return reply;
+    // Run the commands
+    return _set_on_all_nodes(model_name, db_nodes, cmds);
 }
 
 // Set a script from a string buffer in the database for future execution
@@ -395,29 +528,23 @@ CommandReply RedisCluster::set_script(const std::string& key,
                                       const std::string& device,
                                       std::string_view script)
 {
-    CommandReply reply;
-    std::vector<DBNode>::const_iterator node = _db_nodes.cbegin();
-    for ( ; node != _db_nodes.cend(); node++) {
+    std::vector<DBNode> db_nodes = _get_db_nodes();
+    std::vector<CompoundCommand> cmds(db_nodes.size());
+    for (size_t i = 0; i < db_nodes.size(); i++) {
         // Build the node prefix
-        std::string prefix_key = "{" + node->prefix + "}." + key;
+        std::string prefix_key = "{" + db_nodes[i].prefix + "}." + key;
 
         // Build the SCRIPTSET command
-        SingleKeyCommand cmd;
+        CompoundCommand& cmd = cmds[i];
         cmd.add_field("AI.SCRIPTSET");
         cmd.add_field(prefix_key, true);
         cmd.add_field(device);
         cmd.add_field("SOURCE");
         cmd.add_field_ptr(script);
-
-        // Run the command
-        reply = run(cmd);
-        if (reply.has_error() > 0) {
-            throw SRRuntimeException("SetModel failed for node " + node->name);
-        }
     }
 
-    // Done
-    return reply;
+    // Run the commands
+    return _set_on_all_nodes(key, db_nodes, cmds);
 }
 
 // Run a model in the database using the specificed input and output tensors
@@ -425,60 +552,23 @@ CommandReply RedisCluster::run_model(const std::string& key,
                                      std::vector<std::string> inputs,
                                      std::vector<std::string> outputs)
 {
-    /*  For this version of run model, we have to copy all
-        input and output tensors, so we will randomly select
-        a model.  We can't use rand, because MPI would then
-        have the same random number across all ranks.  Instead
-        We will choose it based on the db of the first input tensor.
-    */
-
-    uint16_t hash_slot = _get_hash_slot(inputs[0]);
-    uint16_t db_index = _get_dbnode_index(hash_slot, 0, _db_nodes.size()-1);
-    DBNode* db = &(_db_nodes[db_index]);
-    if (db == NULL) {
-        throw SRRuntimeException("Missing DB node found in run_model");
-    }
-
-    // Generate temporary names so that all keys go to same slot
-    std::vector<std::string> tmp_inputs = _get_tmp_names(inputs, db->prefix);
-    std::vector<std::string> tmp_outputs = _get_tmp_names(outputs, db->prefix);
-
-    // Copy all input tensors to temporary names to align hash slots
-    copy_tensors(inputs, tmp_inputs);
+    // Choose the copy of the model that needs the fewest tensors moved
+    DBNode db = _get_model_script_node(inputs, outputs);
+    std::vector<std::string> run_inputs = _get_run_names(inputs, db);
+    std::vector<std::string> run_outputs = _get_run_names(outputs, db);
 
     // Build the MODELRUN command
-    std::string model_name = "{" + db->prefix + "}." + std::string(key);
+    std::string model_name = "{" + db.prefix + "}." + std::string(key);
     CompoundCommand cmd;
     cmd.add_field("AI.MODELRUN");
     cmd.add_field(model_name, true);
     cmd.add_field("INPUTS");
-    cmd.add_fields(tmp_inputs);
+    cmd.add_fields(run_inputs);
     cmd.add_field("OUTPUTS");
-    cmd.add_fields(tmp_outputs);
+    cmd.add_fields(run_outputs);
 
     // Run it
-    CommandReply reply = run(cmd);
-    if (reply.has_error() > 0) {
-        std::string error("run_model failed for node ");
-        error += db_index;
-        throw SRRuntimeException(error);
-    }
-
-    // Store the outputs back to the database
-    copy_tensors(tmp_outputs, outputs);
-
-    // Clean up the temp keys
-    std::vector<std::string> keys_to_delete;
-    keys_to_delete.insert(keys_to_delete.end(),
-                            tmp_outputs.begin(),
-                            tmp_outputs.end());
-    keys_to_delete.insert(keys_to_delete.end(),
-                            tmp_inputs.begin(),
-                            tmp_inputs.end());
-    _delete_keys(keys_to_delete);
-
-    // Done
-    return reply;
+    return _run_with_transfers(cmd, inputs, run_inputs, outputs, run_outputs);
 }
 
 // Run a script function in the database using the specificed input
@@ -488,63 +578,31 @@ CommandReply RedisCluster::run_script(const std::string& key,
                                       std::vector<std::string> inputs,
                                       std::vector<std::string> outputs)
 {
-    // Locate the DB node for the script
-    uint16_t hash_slot = _get_hash_slot(inputs[0]);
-    uint16_t db_index = _get_dbnode_index(hash_slot, 0, _db_nodes.size() - 1);
-    DBNode* db = &(_db_nodes[db_index]);
-    if (db == NULL) {
-        throw SRRuntimeException("Missing DB node found in run_script");
-    }
-
-    // Generate temporary names so that all keys go to same slot
-    std::vector<std::string> tmp_inputs = _get_tmp_names(inputs, db->prefix);
-    std::vector<std::string> tmp_outputs = _get_tmp_names(outputs, db->prefix);
-
-    // Copy all input tensors to temporary names to align hash slots
-    copy_tensors(inputs, tmp_inputs);
-    std::string script_name = "{" + db->prefix + "}." + std::string(key);
+    // Choose the copy of the script that needs the fewest tensors moved
+    DBNode db = _get_model_script_node(inputs, outputs);
+    std::vector<std::string> run_inputs = _get_run_names(inputs, db);
+    std::vector<std::string> run_outputs = _get_run_names(outputs, db);
 
     // Build the SCRIPTRUN command
+    std::string script_name = "{" + db.prefix + "}." + std::string(key);
     CompoundCommand cmd;
-    CommandReply reply;
     cmd.add_field("AI.SCRIPTRUN");
     cmd.add_field(script_name, true);
     cmd.add_field(function);
     cmd.add_field("INPUTS");
-    cmd.add_fields(tmp_inputs);
+    cmd.add_fields(run_inputs);
     cmd.add_field("OUTPUTS");
-    cmd.add_fields(tmp_outputs);
+    cmd.add_fields(run_outputs);
 
     // Run it
-    reply = run(cmd);
-    if (reply.has_error() > 0) {
-        std::string error("run_model failed for node ");
-        error += db_index;
-        throw SRRuntimeException(error);
-    }
-
-    // Store the output back to the database
-    copy_tensors(tmp_outputs, outputs);
-
-    // Clean up temp keys
-    std::vector<std::string> keys_to_delete;
-    keys_to_delete.insert(keys_to_delete.end(),
-                            tmp_outputs.begin(),
-                            tmp_outputs.end());
-    keys_to_delete.insert(keys_to_delete.end(),
-                            tmp_inputs.begin(),
-                            tmp_inputs.end());
-    _delete_keys(keys_to_delete);
-
-    // Done
-    return reply;
+    return _run_with_transfers(cmd, inputs, run_inputs, outputs, run_outputs);
 }
 
 // Retrieve the model from the database
 CommandReply RedisCluster::get_model(const std::string& key)
 {
     // Build the node prefix
-    std::string prefixed_str = "{" + _db_nodes[0].prefix + "}." + key;
+    std::string prefixed_str = get_model_script_key(key);
 
     // Build the MODELGET command
     SingleKeyCommand cmd;
@@ -559,7 +617,7 @@ CommandReply RedisCluster::get_model(const std::string& key)
 // Retrieve the script from the database
 CommandReply RedisCluster::get_script(const std::string& key)
 {
-    std::string prefixed_str = "{" + _db_nodes[0].prefix + "}." + key;
+    std::string prefixed_str = get_model_script_key(key);
 
     SingleKeyCommand cmd;
     cmd.add_field("AI.SCRIPTGET");
@@ -585,8 +643,8 @@ CommandReply RedisCluster::get_model_script_ai_info(const std::string& address,
                                  "not match a cluster shard address.");
     }
 
-    std::string host_port = host + ":" + std::to_string(port);
-    std::string db_prefix = _address_node_map.at(host_port)->prefix;
+    std::string host_port = _get_node_address(host, port);
+    std::string db_prefix = _get_address_prefix(host_port);
 
     std::string prefixed_key = "{" + db_prefix + "}." + key;
 
@@ -603,17 +661,35 @@ CommandReply RedisCluster::get_model_script_ai_info(const std::string& address,
     return run(cmd);
 }
 
-inline CommandReply RedisCluster::_run(const Command& cmd, std::string db_prefix)
+inline CommandReply RedisCluster::_run(const Command& cmd, uint16_t hash_slot)
 {
-    std::string_view sv_prefix(db_prefix.data(), db_prefix.size());
+    // The db node named by the most recent redirect, if any
+    sw::redis::Redis* redirect = nullptr;
+    bool asking = false;
 
     // Execute the commmand
     for (int i = 1; i <= _command_attempts; i++) {
         try {
-            sw::redis::Redis db = _redis_cluster->redis(sv_prefix, false);
-            CommandReply reply = db.command(cmd.cbegin(), cmd.cend());
+            sw::redis::Redis* db = redirect;
+            if (db == nullptr)
+                db = _get_slot_connection(hash_slot);
+
+            CommandReply reply;
+            if (asking) {
+                // An ASK redirect only holds for a single command
+                asking = false;
+                redirect = nullptr;
+                AddressAnyCommand asking_cmd;
+                asking_cmd.add_field("ASKING");
+                std::vector<Command*> cmds = {&asking_cmd,
+                                              const_cast<Command*>(&cmd)};
+                reply = std::move(_run_pipeline(*db, cmds)[1]);
+            }
+            else {
+                reply = _exec_command(*db, cmd);
+            }
             if (reply.has_error() == 0) {
-                _last_prefix = db_prefix;
+                _last_hash_slot = hash_slot;
                 return reply;
             }
 
@@ -626,22 +702,53 @@ inline CommandReply RedisCluster::_run(const Command& cmd, std::string db_prefix
             // Exception is already prepared, just propagate it
             throw;
         }
+        catch (sw::redis::MovedError& e) {
+            // The hash slot now lives on another db node.  Retry there
+            // right away unless we're out of chances.
+            _note_moved_slot(e.slot(), e.node());
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis MOVED error when executing command: ") +
+                    e.what());
+            }
+            redirect = _get_address_connection(e.node().host, e.node().port);
+            continue;
+        }
+        catch (sw::redis::AskError& e) {
+            // The hash slot is being migrated, and the key has already
+            // been moved.  Retry on the importing db node right away
+            // unless we're out of chances.
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis ASK error when executing command: ") +
+                    e.what());
+            }
+            redirect = _get_address_connection(e.node().host, e.node().port);
+            asking = true;
+            continue;
+        }
         catch (sw::redis::IoError &e) {
-            // For an error from Redis, retry unless we're out of chances
+            // For an error from Redis, retry unless we're out of chances.
+            // The db node may have failed over, so remap the cluster.
             if (i == _command_attempts) {
                 throw SRDatabaseException(
                     std::string("Redis IO error when executing commend: ") +
                     e.what());
             }
+            redirect = nullptr;
+            _refresh_topology();
             // else, Fall through for a retry
         }
         catch (sw::redis::ClosedError &e) {
-            // For an error from Redis, retry unless we're out of chances
+            // For an error from Redis, retry unless we're out of chances.
+            // The db node may have failed over, so remap the cluster.
             if (i == _command_attempts) {
                 throw SRDatabaseException(
                     std::string("Redis Closed error when executing commend: ") +
                     e.what());
             }
+            redirect = nullptr;
+            _refresh_topology();
             // else, Fall through for a retry
         }
         catch (sw::redis::Error &e) {
@@ -671,6 +778,164 @@ inline CommandReply RedisCluster::_run(const Command& cmd, std::string db_prefix
     throw SRTimeoutException("Unable to execute command " + cmd.first_field());
 }
 
+// Pipeline a group of Command to the db node that serves a hash slot
+std::vector<CommandReply>
+RedisCluster::_run_group(std::vector<Command*>& cmds, uint16_t hash_slot,
+                         TensorBlobSink* sink)
+{
+    std::vector<CommandReply> replies = _exec_group(cmds, hash_slot, sink);
+    _follow_redirects(replies, cmds);
+    return replies;
+}
+
+// Check the replies of a pipelined group and run the redirected
+// Command again
+void RedisCluster::_follow_redirects(std::vector<CommandReply>& replies,
+                                     std::vector<Command*>& cmds)
+{
+    _check_pipeline_replies(replies, cmds, true);
+
+    // Run the redirected Command again in order
+    for (size_t j = 0; j < replies.size(); j++) {
+        if (replies[j].has_error() == 0)
+            continue;
+        _note_moved_reply(replies[j]);
+        replies[j] = _run(*cmds[j], _get_cmd_hash_slot(cmds[j]));
+    }
+}
+
+// Run Command as one MULTI/EXEC transaction on the db node that
+// serves a hash slot
+CommandReply RedisCluster::_run_transaction(std::vector<Command*>& cmds,
+                                            uint16_t hash_slot)
+{
+    AddressAnyCommand multi_cmd;
+    multi_cmd.add_field("MULTI");
+    AddressAnyCommand exec_cmd;
+    exec_cmd.add_field("EXEC");
+    std::vector<Command*> txn;
+    txn.push_back(&multi_cmd);
+    txn.insert(txn.end(), cmds.begin(), cmds.end());
+    txn.push_back(&exec_cmd);
+
+    // Command queued while the hash slot is being moved receive a
+    // MOVED or ASK reply, and the transaction is aborted.  Commands
+    // of a transaction cannot be run again on their own, so the
+    // whole transaction is sent again once the slot is remapped.
+    for (int i = 1; i <= _command_attempts; i++) {
+        std::vector<CommandReply> replies = _exec_group(txn, hash_slot);
+        bool redirected = false;
+        for (size_t j = 0; j < replies.size(); j++) {
+            if (replies[j].has_error() > 0 && _is_redirect(replies[j])) {
+                redirected = true;
+                _note_moved_reply(replies[j]);
+            }
+        }
+        if (!redirected) {
+            _check_pipeline_replies(replies, txn);
+            return std::move(replies.back());
+        }
+
+        // Sleep before the next attempt
+        std::this_thread::sleep_for(std::chrono::milliseconds(_command_interval));
+    }
+
+    // If we get here, we've run out of retry attempts
+    throw SRTimeoutException("Unable to execute transaction during a "\
+                             "remap of the cluster");
+}
+
+// Send a group of Command to the db node that serves a hash slot and
+// collect the replies, retrying on connection errors
+std::vector<CommandReply>
+RedisCluster::_exec_group(std::vector<Command*>& cmds, uint16_t hash_slot,
+                          TensorBlobSink* sink)
+{
+    // A PING is pipelined behind the group so that the MOVED and
+    // ASK replies of the group are returned rather than thrown, as
+    // only an error reply to the final Command is thrown
+    AddressAnyCommand ping_cmd;
+    ping_cmd.add_field("PING");
+    std::vector<Command*> pipeline(cmds);
+    pipeline.push_back(&ping_cmd);
+
+    std::vector<CommandReply> replies;
+    for (int i = 1; i <= _command_attempts; i++) {
+        try {
+            replies = _exec_pipeline(*_get_slot_connection(hash_slot),
+                                     pipeline, sink);
+            break;
+        }
+        catch (SmartRedis::Exception& e) {
+            // Exception is already prepared, just propagate it
+            throw;
+        }
+        catch (sw::redis::IoError &e) {
+            // For an error from Redis, retry unless we're out of chances.
+            // The db node may have failed over, so remap the cluster.
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis IO error when executing pipeline: ") +
+                    e.what());
+            }
+            _refresh_topology();
+        }
+        catch (sw::redis::ClosedError &e) {
+            // For an error from Redis, retry unless we're out of chances.
+            // The db node may have failed over, so remap the cluster.
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis Closed error when executing pipeline: ") +
+                    e.what());
+            }
+            _refresh_topology();
+        }
+        catch (sw::redis::Error &e) {
+            // For other errors from Redis, report them immediately
+            throw SRRuntimeException(
+                std::string("Redis error when executing pipeline: ") +
+                e.what());
+        }
+        catch (std::exception& e) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                std::string("Unexpected exception executing pipeline: ") +
+                e.what());
+        }
+        catch (...) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                "Non-standard exception encountered executing pipeline");
+        }
+
+        // Sleep before the next attempt
+        std::this_thread::sleep_for(std::chrono::milliseconds(_command_interval));
+    }
+    if (replies.size() == 0)
+        throw SRTimeoutException("Unable to execute command pipeline");
+    replies.pop_back();
+    return replies;
+}
+
+// Update the hash slot map from a MOVED reply
+void RedisCluster::_note_moved_reply(CommandReply& reply)
+{
+    // A MOVED reply has the form "MOVED <hash slot> <host>:<port>"
+    std::vector<std::string> errors = reply.get_reply_errors();
+    if (errors.size() != 1 || errors[0].rfind("MOVED ", 0) != 0)
+        return;
+    const std::string& error = errors[0];
+    size_t slot_end = error.find(' ', 6);
+    size_t port_start = error.rfind(':');
+    if (slot_end != std::string::npos &&
+        port_start != std::string::npos && port_start > slot_end) {
+        sw::redis::Node node;
+        node.host = error.substr(slot_end + 1, port_start - slot_end - 1);
+        node.port = std::stoi(error.substr(port_start + 1));
+        _note_moved_slot(std::stoul(error.substr(6, slot_end - 6)), node);
+    }
+}
+
 // Connect to the cluster at the address and port
 inline void RedisCluster::_connect(std::string address_port)
 {
@@ -721,13 +986,95 @@ inline void RedisCluster::_connect(std::string address_port)
                              std::to_string(_connection_attempts) + "tries");
 }
 
+// Connect to a co-located db node through its Unix domain socket
+std::string RedisCluster::_connect_local_socket(const std::string& address_port)
+{
+    if (address_port.rfind(_UNIX_SCHEME, 0) != 0)
+        return address_port;
+
+    sw::redis::ConnectionOptions options;
+    options.type = sw::redis::ConnectionType::UNIX;
+    options.path = address_port.substr(_UNIX_SCHEME.size());
+    sw::redis::ConnectionPoolOptions pool_options;
+    pool_options.size = _connections_per_node;
+
+    AddressAnyCommand cmd;
+    cmd.add_field("CLUSTER");
+    cmd.add_field("NODES");
+
+    for (int i = 1; i <= _connection_attempts; i++) {
+        try {
+            std::unique_ptr<sw::redis::Redis> db(
+                new sw::redis::Redis(options, pool_options));
+            CommandReply reply(db->command(cmd.begin(), cmd.end()));
+            if (reply.has_error() > 0)
+                throw SRRuntimeException("CLUSTER NODES command failed");
+
+            // Each line is "<id> <ip:port@cport> <flags> ..." and the
+            // flags of the db node that answered contain "myself"
+            std::string nodes(reply.str(), reply.str_len());
+            std::string address;
+            size_t line_start = 0;
+            while (address.empty() && line_start < nodes.size()) {
+                size_t line_end = nodes.find('\n', line_start);
+                if (line_end == std::string::npos)
+                    line_end = nodes.size();
+                std::string line =
+                    nodes.substr(line_start, line_end - line_start);
+                line_start = line_end + 1;
+
+                size_t addr_start = line.find(' ');
+                if (addr_start == std::string::npos)
+                    continue;
+                size_t addr_end = line.find(' ', addr_start + 1);
+                if (addr_end == std::string::npos)
+                    continue;
+                size_t flags_end = line.find(' ', addr_end + 1);
+                std::string flags = line.substr(addr_end + 1,
+                                                flags_end - addr_end - 1);
+                if (flags.find("myself") == std::string::npos)
+                    continue;
+                address = line.substr(addr_start + 1,
+                                      addr_end - addr_start - 1);
+                address = address.substr(0, address.find('@'));
+            }
+            if (address.empty() || address[0] == ':') {
+                throw SRRuntimeException("The db node at " + address_port +
+                                         " did not report its cluster "\
+                                         "address");
+            }
+
+            _local_socket = options.path;
+            _local_address = address;
+            _set_raw_address(db.get(), options.path);
+            std::lock_guard<std::mutex> lock(_node_connections_mutex);
+            _node_connections[address] = std::move(db);
+            return "tcp://" + address;
+        }
+        catch (std::bad_alloc& e) {
+            throw SRBadAllocException("Unix domain socket connection");
+        }
+        catch (sw::redis::Error& e) {
+            // For an error from Redis, retry unless we're out of chances
+            if (i == _connection_attempts) {
+                throw SRDatabaseException(
+                    std::string("Unable to connect to backend database: ") +
+                    e.what());
+            }
+        }
+
+        // Sleep before the next attempt
+        std::this_thread::sleep_for(std::chrono::milliseconds(_connection_interval));
+    }
+
+    // If we get here, we failed to establish a connection
+    throw SRTimeoutException(std::string("Connection attempt failed after ") +
+                             std::to_string(_connection_attempts) + "tries");
+}
+
 // Map the RedisCluster via the CLUSTER SLOTS command
 inline void RedisCluster::_map_cluster()
 {
-    // Clear out our old map
-    _db_nodes.clear();
-    _address_node_map.clear();
-
     // Build the CLUSTER SLOTS command
     AddressAnyCommand cmd;
     cmd.add_field("CLUSTER");
@@ -744,9 +1091,9 @@ inline void RedisCluster::_map_cluster()
     _parse_reply_for_slots(reply);
 }
 
-// Get the prefix that can be used to address the correct database
+// Get the hash slot that can be used to address the correct database
 // for a given command
-std::string RedisCluster::_get_db_node_prefix(Command& cmd)
+uint16_t RedisCluster::_get_keys_hash_slot(Command& cmd)
 {
     // Extract the keys from the command
     std::vector<std::string> keys = cmd.get_keys();
@@ -755,24 +1102,78 @@ std::string RedisCluster::_get_db_node_prefix(Command& cmd)
                                  " does not have a key value.");
     }
 
-    // Walk through the keys to find the prefix
-    std::string prefix;
-    std::vector<std::string>::iterator key_it = keys.begin();
+    // Walk through the keys to check that they share a db node
+    uint16_t first_slot = _get_hash_slot(keys[0]);
+    std::shared_lock<std::shared_mutex> lock(_topology_mutex);
+    uint16_t first_index = _get_dbnode_index(first_slot);
+    std::vector<std::string>::iterator key_it = keys.begin() + 1;
     for ( ; key_it != keys.end(); key_it++) {
         uint16_t hash_slot = _get_hash_slot(*key_it);
-        uint16_t db_index = _get_dbnode_index(hash_slot, 0,
-                                           _db_nodes.size() - 1);
-        if (prefix.size() == 0) {
-            prefix = _db_nodes[db_index].prefix;
-        }
-        else if (prefix != _db_nodes[db_index].prefix) {
+        if (_get_dbnode_index(hash_slot) != first_index) {
             throw SRRuntimeException("Multi-key commands are not valid: " +
                                      cmd.to_string());
         }
     }
 
     // Done
-    return prefix;
+    return first_slot;
+}
+
+// Get a hash slot of the db node that a Command in a CommandList addresses
+uint16_t RedisCluster::_get_cmd_hash_slot(Command* cmd)
+{
+    // Address-at Command name their db node explicitly
+    AddressAtCommand* aat_cmd = dynamic_cast<AddressAtCommand*>(cmd);
+    if (aat_cmd != NULL) {
+        if (!is_addressable(aat_cmd->get_address(), aat_cmd->get_port()))
+            throw SRRuntimeException("Redis has failed to find database");
+        return _get_address_hash_slot(
+                   _get_node_address(aat_cmd->get_address(),
+                                     aat_cmd->get_port()));
+    }
+
+    // Address-any Command can go to any db node
+    if (dynamic_cast<AddressAnyCommand*>(cmd) != NULL)
+        return _last_hash_slot;
+
+    // Everything else is routed by its keys
+    if (!cmd->has_keys())
+        throw SRRuntimeException("Redis has failed to find database");
+    return _get_keys_hash_slot(*cmd);
+}
+
+// Copy a tensor by fetching it and putting it back under the destination key
+CommandReply RedisCluster::_client_side_copy(const std::string& src_key,
+                                             const std::string& dest_key)
+{
+    // Build the GET command
+    GetTensorCommand cmd_get;
+    cmd_get.add_field("AI.TENSORGET");
+    cmd_get.add_field(src_key, true);
+    cmd_get.add_field("META");
+    cmd_get.add_field("BLOB");
+
+    // Run the GET command
+    CommandReply cmd_get_reply = run(cmd_get);
+    if (cmd_get_reply.has_error() > 0)
+        throw SRRuntimeException("Failed to find tensor " + src_key);
+
+    // Decode the tensor
+    std::vector<size_t> dims = cmd_get.get_dims(cmd_get_reply);
+    std::string_view blob = cmd_get.get_data_blob(cmd_get_reply);
+    SRTensorType type = cmd_get.get_data_type(cmd_get_reply);
+
+    // Build the PUT command
+    MultiKeyCommand cmd_put;
+    cmd_put.add_field("AI.TENSORSET");
+    cmd_put.add_field(dest_key, true);
+    cmd_put.add_field(TENSOR_STR_MAP.at(type));
+    cmd_put.add_fields(dims);
+    cmd_put.add_field("BLOB");
+    cmd_put.add_field_ptr(blob);
+
+    // Run the PUT command
+    return run(cmd_put);
 }
 
 // Process the CommandReply for CLUSTER SLOTS to build DBNode information
@@ -787,24 +1188,46 @@ inline void RedisCluster::_parse_reply_for_slots(CommandReply& reply)
        2) "name"
     */
     size_t n_db_nodes = reply.n_elements();
-    _db_nodes = std::vector<DBNode>(n_db_nodes);
+    std::vector<DBNode> db_nodes(n_db_nodes);
 
     for (size_t i = 0; i < n_db_nodes; i++) {
-        _db_nodes[i].lower_hash_slot = reply[i][0].integer();
-        _db_nodes[i].upper_hash_slot = reply[i][1].integer();
-        _db_nodes[i].ip = std::string(reply[i][2][0].str(),
-                                            reply[i][2][0].str_len());
-        _db_nodes[i].port = reply[i][2][1].integer();
-        _db_nodes[i].name = std::string(reply[i][2][2].str(),
-                                              reply[i][2][2].str_len());
-        _db_nodes[i].prefix = _get_crc16_prefix(_db_nodes[i].lower_hash_slot);
-        _address_node_map.insert({_db_nodes[i].ip + ":"
-                                    + std::to_string(_db_nodes[i].port),
-                                    &_db_nodes[i]});
+        db_nodes[i].lower_hash_slot = reply[i][0].integer();
+        db_nodes[i].upper_hash_slot = reply[i][1].integer();
+        db_nodes[i].ip = std::string(reply[i][2][0].str(),
+                                     reply[i][2][0].str_len());
+        db_nodes[i].port = reply[i][2][1].integer();
+        db_nodes[i].name = std::string(reply[i][2][2].str(),
+                                       reply[i][2][2].str_len());
+        db_nodes[i].prefix = _get_crc16_prefix(db_nodes[i].lower_hash_slot);
     }
 
     //Put the vector of db nodes in order based on lower hash slot
-    std::sort(_db_nodes.begin(), _db_nodes.end());
+    std::sort(db_nodes.begin(), db_nodes.end());
+
+    // Index the sorted db nodes by address and by hash slot, and
+    // resolve the connection to each of them
+    std::unordered_map<std::string, DBNode*> address_node_map;
+    std::vector<uint16_t> slot_nodes(_N_HASH_SLOTS, _NO_DB_NODE);
+    std::vector<sw::redis::Redis*> db_connections(n_db_nodes);
+    for (size_t i = 0; i < n_db_nodes; i++) {
+        db_connections[i] = _get_address_connection(db_nodes[i].ip,
+                                                    db_nodes[i].port);
+        address_node_map.insert({db_nodes[i].ip + ":"
+                                 + std::to_string(db_nodes[i].port),
+                                 &db_nodes[i]});
+        uint64_t upper = std::min<uint64_t>(db_nodes[i].upper_hash_slot,
+                                            _N_HASH_SLOTS - 1);
+        for (uint64_t slot = db_nodes[i].lower_hash_slot; slot <= upper; slot++)
+            slot_nodes[slot] = i;
+    }
+
+    // Swap in the new map.  Swapping the vectors keeps the DBNode
+    // addresses that were put in the address map valid.
+    std::unique_lock<std::shared_mutex> lock(_topology_mutex);
+    _db_nodes.swap(db_nodes);
+    _address_node_map.swap(address_node_map);
+    _slot_nodes.swap(slot_nodes);
+    _db_connections.swap(db_connections);
 }
 
 // Perform inverse CRC16 XOR and shifts
@@ -927,180 +1350,414 @@ uint16_t RedisCluster::_get_hash_slot(const std::string& key)
 }
 
 // Get the index of the DBNode responsible for the hash slot
-uint16_t RedisCluster::_get_dbnode_index(uint16_t hash_slot,
-                                   unsigned lhs, unsigned rhs)
+uint16_t RedisCluster::_get_dbnode_index(uint16_t hash_slot)
 {
-    // Find the DBNode via binary search
-    uint16_t m = (lhs + rhs) / 2;
-
-    // If this is the correct slot, we're done
-    if (_db_nodes[m].lower_hash_slot <= hash_slot &&
-        _db_nodes[m].upper_hash_slot >= hash_slot) {
-        return m;
+    uint16_t db_index = _slot_nodes[hash_slot % _N_HASH_SLOTS];
+    if (db_index == _NO_DB_NODE) {
+        throw SRRuntimeException("No database node serves hash slot " +
+                                 std::to_string(hash_slot));
     }
+    return db_index;
+}
 
-    // Otherwise search in the appropriate half
-    else {
-        if (_db_nodes[m].lower_hash_slot > hash_slot)
-            return _get_dbnode_index(hash_slot, lhs, m - 1);
-        else
-            return _get_dbnode_index(hash_slot, m + 1, rhs);
+// Get the db node whose copy of a model or script needs the fewest
+// tensors to be moved for a run
+DBNode RedisCluster::_get_model_script_node(
+    const std::vector<std::string>& inputs,
+    const std::vector<std::string>& outputs)
+{
+    /* RedisAI needs the model or script and every tensor of a run to
+    be in one hash slot.  Each db node keeps its copy of a model or
+    script in the hash slot of its prefix, and tensors that are
+    already in that hash slot are used in place.  Choose the db node
+    whose prefix hash slot holds the most of them, and fall back to
+    the db node of the first input when none of them do.
+    */
+    std::unordered_map<uint16_t, size_t> slot_tally;
+    for (size_t i = 0; i < inputs.size(); i++)
+        slot_tally[_get_hash_slot(inputs[i])]++;
+    for (size_t i = 0; i < outputs.size(); i++)
+        slot_tally[_get_hash_slot(outputs[i])]++;
+
+    std::vector<DBNode> db_nodes = _get_db_nodes();
+    size_t max_tally = 0;
+    size_t max_index = 0;
+    for (size_t i = 0; i < db_nodes.size(); i++) {
+        auto it = slot_tally.find(db_nodes[i].lower_hash_slot);
+        if (it != slot_tally.end() && it->second > max_tally) {
+            max_tally = it->second;
+            max_index = i;
+        }
     }
+    if (max_tally > 0)
+        return db_nodes[max_index];
+    if (inputs.size() > 0)
+        return _get_slot_node(_get_hash_slot(inputs[0]));
+    return _get_slot_node(0);
 }
 
-// Attaches a prefix and constant suffix to keys to enforce identical
-//  hash slot constraint
+// Get the keys that tensors are run under on a db node
 std::vector<std::string>
-RedisCluster::_get_tmp_names(std::vector<std::string> names,
-                             std::string db_prefix)
-{
-    std::vector<std::string> tmp;
-    std::vector<std::string>::iterator it = names.begin();
-    for ( ; it != names.end(); it++) {
-        std::string new_key = "{" + db_prefix + "}." + *it + ".TMP";
-        tmp.push_back(new_key);
+RedisCluster::_get_run_names(const std::vector<std::string>& names,
+                             const DBNode& db)
+{
+    std::vector<std::string> run_names;
+    run_names.reserve(names.size());
+    std::vector<std::string>::const_iterator it = names.cbegin();
+    for ( ; it != names.cend(); it++) {
+        if (_get_hash_slot(*it) == db.lower_hash_slot)
+            run_names.push_back(*it);
+        else
+            run_names.push_back("{" + db.prefix + "}." + *it + ".TMP");
     }
-    return tmp;
+    return run_names;
 }
 
-// Delete multiple keys (assumesthat all keys use the same hash slot)
-void RedisCluster::_delete_keys(std::vector<std::string> keys)
+// Build a Command that restores a serialized value under a key
+inline void RedisCluster::_build_restore(SingleKeyCommand& cmd,
+                                         const std::string& key,
+                                         CommandReply& dump)
 {
-    // Build the command
-    MultiKeyCommand cmd;
-    cmd.add_field("DEL");
-    cmd.add_fields(keys, true);
-
-    // Run it, ignoring failure
-    (void)run(cmd);
+    cmd.add_field("RESTORE");
+    cmd.add_field(key, true);
+    cmd.add_field("0");
+    cmd.add_field_ptr(std::string_view(dump.str(), dump.str_len()));
+    cmd.add_field("REPLACE");
 }
 
-// Run a model in the database that uses dagrun
-void RedisCluster::__run_model_dagrun(const std::string& key,
-                                      std::vector<std::string> inputs,
-                                      std::vector<std::string> outputs)
+// Run a model or script, moving the tensors that are outside of its
+// hash slot in and out around the run
+CommandReply RedisCluster::_run_with_transfers(
+    const CompoundCommand& run_cmd,
+    const std::vector<std::string>& inputs,
+    const std::vector<std::string>& run_inputs,
+    const std::vector<std::string>& outputs,
+    const std::vector<std::string>& run_outputs)
 {
-    /* This function will run a RedisAI model.  Because the RedisAI
-    AI.RUNMODEL and AI.DAGRUN commands assume that the tensors
-    and model are all on the same node.  As a result, we will
-    have to retrieve all input tensors that are not on the same
-    node as the model and set temporary
-    */
-
-    // TODO We need to make sure that no other clients are using the
-    // same keys and model because we may end up overwriting or having
-    // race conditions on who can use the model, etc.
-
-    DBNode* db = _get_model_script_db(key, inputs, outputs);
-
-    // Create list of input tensors that do not hash to db slots
-    std::unordered_set<std::string> remote_inputs;
+    // Fetch the serialized inputs that have to be moved.  The fetches
+    // go to all of their db nodes at once.
+    CommandList dump_cmds;
     for (size_t i = 0; i < inputs.size(); i++) {
-        uint16_t hash_slot = _get_hash_slot(inputs[i]);
-        if (hash_slot < db->lower_hash_slot ||
-            hash_slot > db->upper_hash_slot) {
-            remote_inputs.insert(inputs[i]);
-        }
+        if (inputs[i] == run_inputs[i])
+            continue;
+        SingleKeyCommand* cmd = dump_cmds.add_command<SingleKeyCommand>();
+        cmd->add_field("DUMP");
+        cmd->add_field(inputs[i], true);
     }
+    std::vector<CommandReply> dumps = run(dump_cmds);
 
-    // Retrieve tensors that do not hash to db,
-    // rename the tensors to {prefix}.tensor_name.TMP
-    // TODO we need to make sure users don't use the .TMP suffix
-    // or check that the key does not exist
+    // Restore the inputs, run, fetch the outputs that have to be moved
+    // and remove the temporary keys in one pipeline to the run db node
+    CommandList run_cmds;
+    std::vector<std::string> tmp_keys;
+    size_t n_dumps = 0;
     for (size_t i = 0; i < inputs.size(); i++) {
-        if (remote_inputs.count(inputs[i]) > 0) {
-            std::string new_key = "{" + db->prefix + "}." + inputs[i] + ".TMP";
-            copy_tensor(inputs[i], new_key);
-            remote_inputs.erase(inputs[i]);
-            remote_inputs.insert(new_key);
-            inputs[i] = new_key;
-        }
+        if (inputs[i] == run_inputs[i])
+            continue;
+        CommandReply& dump = dumps[n_dumps++];
+        if (dump.redis_reply_type() != "REDIS_REPLY_STRING")
+            throw SRRuntimeException("Failed to find tensor " + inputs[i]);
+        _build_restore(*run_cmds.add_command<SingleKeyCommand>(),
+                       run_inputs[i], dump);
+        tmp_keys.push_back(run_inputs[i]);
     }
+    size_t run_index = tmp_keys.size();
+    *run_cmds.add_command<CompoundCommand>() = run_cmd;
+    for (size_t i = 0; i < outputs.size(); i++) {
+        if (outputs[i] == run_outputs[i])
+            continue;
+        SingleKeyCommand* cmd = run_cmds.add_command<SingleKeyCommand>();
+        cmd->add_field("DUMP");
+        cmd->add_field(run_outputs[i], true);
+        tmp_keys.push_back(run_outputs[i]);
+    }
+    if (tmp_keys.size() > 0) {
+        MultiKeyCommand* cmd = run_cmds.add_command<MultiKeyCommand>();
+        cmd->add_field("DEL");
+        cmd->add_fields(tmp_keys, true);
+    }
+    std::vector<CommandReply> run_replies = run(run_cmds);
 
-    // Create a renaming scheme for output tensor
-    std::unordered_map<std::string, std::string> remote_outputs;
+    // Restore the outputs under their own keys
+    CommandList restore_cmds;
+    size_t n_out_dumps = run_index + 1;
     for (size_t i = 0; i < outputs.size(); i++) {
-        uint16_t hash_slot = _get_hash_slot(outputs[i]);
-        if (hash_slot < db->lower_hash_slot ||
-            hash_slot > db->upper_hash_slot) {
-            std::string tmp = "{" + db->prefix + "}." + outputs[i] + ".TMP";
-            remote_outputs.insert({outputs[i], tmp});
-            outputs[i] = remote_outputs[outputs[i]];
-        }
+        if (outputs[i] == run_outputs[i])
+            continue;
+        CommandReply& dump = run_replies[n_out_dumps++];
+        if (dump.redis_reply_type() != "REDIS_REPLY_STRING")
+            throw SRRuntimeException("Failed to find tensor " + outputs[i]);
+        _build_restore(*restore_cmds.add_command<SingleKeyCommand>(),
+                       outputs[i], dump);
     }
+    (void)run(restore_cmds);
 
-    // Build the DAGRUN command
-    std::string model_name = "{" + db->prefix + "}." + key;
-    CompoundCommand cmd;
-    cmd.add_field("AI.DAGRUN");
-    cmd.add_field("LOAD");
-    cmd.add_field(std::to_string(inputs.size()));
-    cmd.add_fields(inputs);
-    cmd.add_field("PERSIST");
-    cmd.add_field(std::to_string(outputs.size()));
-    cmd.add_fields(outputs);
-    cmd.add_field("|>");
-    cmd.add_field("AI.MODELRUN");
-    cmd.add_field(model_name, true);
-    cmd.add_field("INPUTS");
-    cmd.add_fields(inputs);
-    cmd.add_field("OUTPUTS");
-    cmd.add_fields(outputs);
+    // Done
+    return std::move(run_replies[run_index]);
+}
 
-    // Run it
-    CommandReply reply = run(cmd);
-    if (reply.has_error()) {
-        throw SRRuntimeException("Failed to execute DAGRUN");
+// Set a model or script on every db node
+CommandReply RedisCluster::_set_on_all_nodes(
+    const std::string& name,
+    const std::vector<DBNode>& db_nodes,
+    std::vector<CompoundCommand>& cmds)
+{
+    size_t n_nodes = db_nodes.size();
+    if (n_nodes == 0)
+        throw SRRuntimeException("No database nodes to set " + name + " on");
+
+    // Look up which db nodes already hold an identical copy.  The
+    // copy itself is checked too, since it may have been deleted
+    // without its digest.
+    std::string digest = _get_replica_digest(cmds[0]);
+    CommandList check_cmds;
+    std::vector<std::string> digest_keys(n_nodes);
+    for (size_t i = 0; i < n_nodes; i++) {
+        std::string prefixed_key = "{" + db_nodes[i].prefix + "}." + name;
+        digest_keys[i] = prefixed_key + _DIGEST_SUFFIX;
+        SingleKeyCommand* exists_cmd = check_cmds.add_command<SingleKeyCommand>();
+        exists_cmd->add_field("EXISTS");
+        exists_cmd->add_field(prefixed_key, true);
+        SingleKeyCommand* get_cmd = check_cmds.add_command<SingleKeyCommand>();
+        get_cmd->add_field("GET");
+        get_cmd->add_field(digest_keys[i], true);
+    }
+    std::vector<CommandReply> checks = run(check_cmds);
+
+    redisReply ok = {};
+    ok.type = REDIS_REPLY_STATUS;
+    ok.str = (char*)"OK";
+    ok.len = 2;
+    const redisReply* ok_reply = &ok;
+
+    // Upload to the other db nodes, at most _MAX_PARALLEL_UPLOADS at
+    // a time.  Each worker takes the next db node until none are left.
+    std::vector<CommandReply> replies(n_nodes);
+    std::vector<std::string> errors(n_nodes);
+    std::atomic<size_t> next_node{0};
+    auto upload = [&]() {
+        for (size_t i = next_node++; i < n_nodes; i = next_node++) {
+            // A db node that is skipped replies as a set would
+            CommandReply& stored = checks[2 * i + 1];
+            if (checks[2 * i].integer() == 1 &&
+                stored.redis_reply_type() == "REDIS_REPLY_STRING" &&
+                std::string(stored.str(), stored.str_len()) == digest) {
+                replies[i] = ok_reply;
+                continue;
+            }
+            try {
+                // The copy and its digest are stored in one transaction
+                // so that the digest always describes the copy next to
+                // it.  The reply to the set is taken from the EXEC reply.
+                SingleKeyCommand digest_cmd;
+                digest_cmd.add_field("SET");
+                digest_cmd.add_field(digest_keys[i], true);
+                digest_cmd.add_field(digest);
+                std::vector<Command*> txn = {&cmds[i], &digest_cmd};
+                CommandReply exec_reply =
+                    _run_transaction(txn, _get_hash_slot(digest_keys[i]));
+                CommandReply set_reply = exec_reply[0];
+                replies[i] = set_reply;
+            }
+            catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+            catch (...) {
+                errors[i] = "Non-standard exception encountered";
+            }
+            if (errors[i].size() == 0)
+                continue;
+
+            // A transaction is not rolled back when the set fails, so
+            // the digest is removed to have the db node set again
+            try {
+                SingleKeyCommand del_cmd;
+                del_cmd.add_field("DEL");
+                del_cmd.add_field(digest_keys[i], true);
+                (void)run(del_cmd);
+            }
+            catch (...) {
+                errors[i] += " (its digest could not be removed)";
+            }
+        }
+    };
+    size_t n_workers = std::min(_MAX_PARALLEL_UPLOADS, n_nodes);
+    std::vector<std::future<void>> workers;
+    for (size_t w = 1; w < n_workers; w++)
+        workers.push_back(std::async(std::launch::async, upload));
+    upload();
+    for (size_t w = 0; w < workers.size(); w++)
+        workers[w].get();
+
+    // Report every db node that failed by name
+    std::string failures;
+    for (size_t i = 0; i < n_nodes; i++) {
+        if (errors[i].size() > 0) {
+            failures += "\n  " + db_nodes[i].name + " (" + db_nodes[i].ip +
+                        ":" + std::to_string(db_nodes[i].port) + "): " +
+                        errors[i];
+        }
+    }
+    if (failures.size() > 0) {
+        throw SRRuntimeException("Failed to set " + name +
+                                 " on database nodes:" + failures);
     }
 
-    // Delete temporary input tensors
-    std::unordered_set<std::string>::const_iterator i_it =
-        remote_inputs.begin();
-    for ( ; i_it !=  remote_inputs.end(); i_it++)
-        delete_tensor(*i_it);
-
-    // Move temporary output to the correct location and
-    // delete temporary output tensors
-    std::unordered_map<std::string, std::string>::const_iterator j_it =
-        remote_outputs.begin();
-    for ( ; j_it != remote_outputs.end(); j_it++)
-        rename_tensor(j_it->second, j_it->first);
+    // Done
+    return std::move(replies.back());
 }
 
-// Retrieve the optimum model prefix for the set of inputs
-DBNode* RedisCluster::_get_model_script_db(const std::string& name,
-                                           std::vector<std::string>& inputs,
-                                           std::vector<std::string>& outputs)
+// Get a digest of a model or script set Command that is the same
+// for every db node
+std::string RedisCluster::_get_replica_digest(const Command& cmd)
 {
-    /* This function calculates the optimal model name to use
-    to run the provided inputs.  If a cluster is not being used,
-    the model name is returned, else a prefixed model name is returned.
+    /* The digest is a 64-bit FNV-1a hash of every field but the
+    key, which is the only field that differs between db nodes.
+    Each field is preceded by its length so that moving bytes
+    between neighbouring fields changes the digest.
     */
+    uint64_t hash = 14695981039346656037ULL;
+    auto add_bytes = [&hash](const char* bytes, size_t n_bytes) {
+        for (size_t i = 0; i < n_bytes; i++) {
+            hash ^= (unsigned char)bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    size_t index = 0;
+    Command::const_iterator field = cmd.cbegin();
+    for ( ; field != cmd.cend(); field++, index++) {
+        if (index == 1)
+            continue;
+        uint64_t n_bytes = field->size();
+        add_bytes((const char*)&n_bytes, sizeof(n_bytes));
+        add_bytes(field->data(), field->size());
+    }
 
-    // TODO we should randomly choose the max if there are multiple maxes
+    char digest[17];
+    std::snprintf(digest, sizeof(digest), "%016llx", (unsigned long long)hash);
+    return std::string(digest);
+}
 
-    std::vector<int> hash_slot_tally(_db_nodes.size(), 0);
+// Remap the cluster on a background thread
+void RedisCluster::_refresh_topology()
+{
+    // Only one remap runs at a time
+    bool expected = false;
+    if (!_refresh_pending.compare_exchange_strong(expected, true))
+        return;
 
-    for (size_t i = 0; i < inputs.size(); i++) {
-        uint16_t hash_slot = _get_hash_slot(inputs[i]);
-        uint16_t db_index = _get_dbnode_index(hash_slot, 0, _db_nodes.size());
-        hash_slot_tally[db_index]++;
-    }
+    std::lock_guard<std::mutex> lock(_refresh_mutex);
+    _refresh_future = std::async(std::launch::async, [this]() {
+        try {
+            _map_cluster();
+        }
+        catch (...) {
+            // Keep the current map.  The next redirect or connection
+            // error will ask for another remap.
+        }
+        _refresh_pending = false;
+    });
+}
 
-    for (size_t i = 0; i < outputs.size(); i++) {
-        uint16_t hash_slot = _get_hash_slot(outputs[i]);
-        uint16_t db_index = _get_dbnode_index(hash_slot, 0, _db_nodes.size());
-        hash_slot_tally[db_index]++;
+// Record that a hash slot has moved to another db node
+void RedisCluster::_note_moved_slot(size_t hash_slot,
+                                    const sw::redis::Node& node)
+{
+    // Route the hash slot to its new db node straight away if we
+    // already know the db node
+    std::string address = node.host + ":" + std::to_string(node.port);
+    {
+        std::unique_lock<std::shared_mutex> lock(_topology_mutex);
+        auto it = _address_node_map.find(address);
+        if (it != _address_node_map.end() && hash_slot < _slot_nodes.size())
+            _slot_nodes[hash_slot] = it->second - _db_nodes.data();
     }
 
-    // Determine which DBNode has the most hashes
-    int max_hash = -1;
-    DBNode* db = NULL;
-    for (size_t i = 0; i < _db_nodes.size(); i++) {
-        if (hash_slot_tally[i] > max_hash) {
-            max_hash = hash_slot_tally[i];
-            db = &(_db_nodes[i]);
-        }
+    // A moved hash slot usually means that others have moved too
+    _refresh_topology();
+}
+
+// Get the DBNode that serves a hash slot
+DBNode RedisCluster::_get_slot_node(uint16_t hash_slot)
+{
+    std::shared_lock<std::shared_mutex> lock(_topology_mutex);
+    return _db_nodes[_get_dbnode_index(hash_slot)];
+}
+
+// Get all of the DBNodes in the cluster
+std::vector<DBNode> RedisCluster::_get_db_nodes()
+{
+    std::shared_lock<std::shared_mutex> lock(_topology_mutex);
+    return _db_nodes;
+}
+
+// Get the prefix of the DBNode at an address
+std::string RedisCluster::_get_address_prefix(const std::string& address)
+{
+    std::shared_lock<std::shared_mutex> lock(_topology_mutex);
+    auto it = _address_node_map.find(address);
+    if (it == _address_node_map.end())
+        throw SRRuntimeException("Redis has failed to find database");
+    return it->second->prefix;
+}
+
+// Get a hash slot of the DBNode at an address
+uint16_t RedisCluster::_get_address_hash_slot(const std::string& address)
+{
+    std::shared_lock<std::shared_mutex> lock(_topology_mutex);
+    auto it = _address_node_map.find(address);
+    if (it == _address_node_map.end())
+        throw SRRuntimeException("Redis has failed to find database");
+    return it->second->lower_hash_slot;
+}
+
+// Get the connection to the db node that serves a hash slot
+sw::redis::Redis* RedisCluster::_get_slot_connection(uint16_t hash_slot)
+{
+    std::shared_lock<std::shared_mutex> lock(_topology_mutex);
+    return _db_connections[_get_dbnode_index(hash_slot)];
+}
+
+// Get the connection to the db node at an address
+sw::redis::Redis* RedisCluster::_get_address_connection(const std::string& host,
+                                                        uint64_t port)
+{
+    std::string address = host + ":" + std::to_string(port);
+    std::lock_guard<std::mutex> lock(_node_connections_mutex);
+    auto it = _node_connections.find(address);
+    if (it != _node_connections.end())
+        return it->second.get();
+
+    // The connections are opened lazily by redis++ on first use
+    sw::redis::ConnectionOptions options;
+    options.host = host;
+    options.port = port;
+    sw::redis::ConnectionPoolOptions pool_options;
+    pool_options.size = _connections_per_node;
+    std::unique_ptr<sw::redis::Redis> db(
+        new sw::redis::Redis(options, pool_options));
+    sw::redis::Redis* db_ptr = db.get();
+    _set_raw_address(db_ptr, address);
+    _node_connections.insert({address, std::move(db)});
+    return db_ptr;
+}
+
+// Get the cluster address of a db node
+std::string RedisCluster::_get_node_address(const std::string& host,
+                                            uint64_t port)
+{
+    if (port == 0 && !_local_socket.empty() && host == _local_socket)
+        return _local_address;
+    return host + ":" + std::to_string(port);
+}
+
+// Initialize the number of connections to each db node
+void RedisCluster::_init_connections_per_node()
+{
+    _init_integer_from_env(_connections_per_node, _CONNS_PER_NODE_ENV_VAR,
+                           _DEFAULT_CONNS_PER_NODE);
+    if (_connections_per_node <= 0) {
+        throw SRParameterException(_CONNS_PER_NODE_ENV_VAR +
+                                   " must be greater than 0.");
     }
-    return db;
 }
@@ -27,6 +27,10 @@
  */
 
 #include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/uio.h>
 #include "redisserver.h"
 #include "srexception.h"
 
@@ -69,22 +73,26 @@ std::string RedisServer::_get_ssdb()
     std::string env_str = std::string(env_char);
     _check_ssdb_string(env_str);
 
-    // Parse the data in it
+    // Parse the data in it.  Unix domain socket entries keep their
+    // unix:// scheme and all others are TCP host:port pairs.
     std::vector<std::string> hosts_ports;
     const char delim = ',';
 
     size_t i_pos = 0;
-    size_t j_pos = env_str.find(delim);
-    while (j_pos != std::string::npos) {
-        hosts_ports.push_back("tcp://"+
-        env_str.substr(i_pos, j_pos - i_pos));
+    while (i_pos < env_str.size()) {
+        size_t j_pos = env_str.find(delim, i_pos);
+        if (j_pos == std::string::npos)
+            j_pos = env_str.size();
+        std::string entry = env_str.substr(i_pos, j_pos - i_pos);
+        if (entry.rfind(_UNIX_SCHEME, 0) == 0)
+            hosts_ports.push_back(entry);
+        else if (entry.size() > 0)
+            hosts_ports.push_back("tcp://" + entry);
         i_pos = j_pos + 1;
-        j_pos = env_str.find(delim, i_pos);
     }
-    // Catch the last value that does not have a trailing ';'
-    if (i_pos < env_str.size())
-        hosts_ports.push_back("tcp://"+
-        env_str.substr(i_pos, j_pos - i_pos));
+    if (hosts_ports.size() == 0)
+        throw SRRuntimeException("The provided SSDB value, " + env_str +
+                                 " does not contain an address.");
 
     // Pick an entry from the list at random, seeding the RNG if needed
     if (!___srand_seeded) {
@@ -103,12 +111,35 @@ std::string RedisServer::_get_ssdb()
 
 // Check that the SSDB environment variable value does not have any errors
 void RedisServer::_check_ssdb_string(const std::string& env_str) {
-    for (size_t i = 0; i < env_str.size(); i++) {
-        char c = env_str[i];
-        if (!isalnum(c) && c != '.' && c != ':' && c != ',') {
-            throw SRRuntimeException("The provided SSDB value, " + env_str +
-                                     " is invalid because of character " + c);
+    size_t i_pos = 0;
+    while (i_pos < env_str.size()) {
+        size_t j_pos = env_str.find(',', i_pos);
+        if (j_pos == std::string::npos)
+            j_pos = env_str.size();
+
+        // Socket paths may also hold '/', '_' and '-'
+        bool is_socket = env_str.compare(i_pos, _UNIX_SCHEME.size(),
+                                         _UNIX_SCHEME) == 0;
+        if (is_socket) {
+            i_pos += _UNIX_SCHEME.size();
+            if (i_pos == j_pos) {
+                throw SRRuntimeException("The provided SSDB value, " +
+                                         env_str + " is invalid because "\
+                                         "of an empty socket path");
+            }
         }
+        for (size_t i = i_pos; i < j_pos; i++) {
+            char c = env_str[i];
+            bool valid = isalnum(c) || c == '.' ||
+                         (is_socket ? (c == '/' || c == '_' || c == '-')
+                                    : c == ':');
+            if (!valid) {
+                throw SRRuntimeException("The provided SSDB value, " +
+                                         env_str + " is invalid because "\
+                                         "of character " + c);
+            }
+        }
+        i_pos = j_pos + 1;
     }
 }
 
@@ -189,4 +220,418 @@ inline void RedisServer::_check_runtime_variables()
                                    " must be less than "
                                    + std::to_string(INT_MAX / 1000));
     }
-}
\ No newline at end of file
+}
+
+// Execute a group of Command on a single database node as one pipeline
+std::vector<CommandReply>
+RedisServer::_run_pipeline(sw::redis::Redis& db, std::vector<Command*>& cmds,
+                           TensorBlobSink* sink)
+{
+    for (int i = 1; i <= _command_attempts; i++) {
+        try {
+            // Run the pipeline
+            std::vector<CommandReply> replies = _exec_pipeline(db, cmds, sink);
+            _check_pipeline_replies(replies, cmds);
+            return replies;
+        }
+        catch (SmartRedis::Exception& e) {
+            // Exception is already prepared, just propagate it
+            throw;
+        }
+        catch (sw::redis::RedirectionError& e) {
+            // MOVED and ASK redirects are followed by the caller
+            throw;
+        }
+        catch (sw::redis::IoError &e) {
+            // For an error from Redis, retry unless we're out of chances
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis IO error when executing pipeline: ") +
+                    e.what());
+            }
+            // else, Fall through for a retry
+        }
+        catch (sw::redis::ClosedError &e) {
+            // For an error from Redis, retry unless we're out of chances
+            if (i == _command_attempts) {
+                throw SRDatabaseException(
+                    std::string("Redis Closed error when executing pipeline: ") +
+                    e.what());
+            }
+            // else, Fall through for a retry
+        }
+        catch (sw::redis::Error &e) {
+            // For other errors from Redis, report them immediately
+            throw SRRuntimeException(
+                std::string("Redis error when executing pipeline: ") +
+                e.what());
+        }
+        catch (std::exception& e) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                std::string("Unexpected exception executing pipeline: ") +
+                e.what());
+        }
+        catch (...) {
+            // Should never hit this, so bail immediately if we do
+            throw SRInternalException(
+                "Non-standard exception encountered executing pipeline");
+        }
+
+        // If we get here, the execution attempt failed.
+        // Sleep before the next attempt
+        std::this_thread::sleep_for(std::chrono::milliseconds(_command_interval));
+    }
+
+    // If we get here, we've run out of retry attempts
+    throw SRTimeoutException("Unable to execute command pipeline");
+}
+
+// Throw on the first error reply of a pipeline
+void RedisServer::_check_pipeline_replies(std::vector<CommandReply>& replies,
+                                          std::vector<Command*>& cmds,
+                                          bool skip_redirects)
+{
+    // On an error response, bail with the server error, naming
+    // the first Command that failed and its key
+    for (size_t j = 0; j < replies.size(); j++) {
+        if (replies[j].has_error() == 0)
+            continue;
+        if (skip_redirects && _is_redirect(replies[j]))
+            continue;
+        std::string msg = "Redis failed to execute command: " +
+                          cmds[j]->first_field();
+        if (cmds[j]->has_keys())
+            msg += " for key " + cmds[j]->get_keys()[0];
+        msg += ": " + replies[j].get_reply_errors()[0];
+        throw SRRuntimeException(msg);
+    }
+}
+
+// Check whether a reply is a MOVED or ASK redirect
+bool RedisServer::_is_redirect(CommandReply& reply)
+{
+    std::vector<std::string> errors = reply.get_reply_errors();
+    return errors.size() == 1 && (errors[0].rfind("MOVED ", 0) == 0 ||
+                                  errors[0].rfind("ASK ", 0) == 0);
+}
+
+// Build a Command that copies a key to another key on the same db node
+// without the value leaving the server
+void RedisServer::_build_server_copy(CompoundCommand& cmd,
+                                     const std::string& src_key,
+                                     const std::string& dest_key)
+{
+    cmd.add_field("EVAL");
+    cmd.add_field(_SERVER_COPY_SCRIPT);
+    cmd.add_field("2");
+    cmd.add_field(src_key, true);
+    cmd.add_field(dest_key, true);
+}
+
+// Send a group of Command to a database node and collect the replies
+std::vector<CommandReply>
+RedisServer::_exec_pipeline(sw::redis::Redis& db, std::vector<Command*>& cmds,
+                            TensorBlobSink* sink)
+{
+    std::vector<CommandReply> replies;
+    if (cmds.size() == 0)
+        return replies;
+    replies.reserve(cmds.size());
+
+    /* hiredis only buffers a command when it is sent, and the
+    buffer is flushed to the socket on the first read.  All of
+    the commands are therefore written back-to-back before any
+    reply is read.  redis-plus-plus reads the reply of the final
+    command itself, so only the preceding replies are read here.
+    Error replies are kept so that they can be reported against
+    the Command that produced them.
+    */
+    auto pipeline = [&replies, &cmds](sw::redis::Connection& connection) {
+        replies.clear();
+        std::vector<Command*>::iterator cmd = cmds.begin();
+        for ( ; cmd != cmds.end(); cmd++) {
+            sw::redis::CmdArgs args;
+            Command::const_iterator field = (*cmd)->cbegin();
+            for ( ; field != (*cmd)->cend(); field++)
+                args.append(*field);
+            connection.send(args);
+        }
+        for (size_t i = 0; i + 1 < cmds.size(); i++)
+            replies.push_back(CommandReply(connection.recv(false)));
+    };
+
+    // redis-plus-plus does not expose the hiredis context of its
+    // connections, so a group that needs it runs on a raw connection
+    bool use_raw = sink != NULL;
+    for (size_t i = 0; i < cmds.size() && !use_raw; i++)
+        use_raw = _use_vectored_send(*cmds[i]);
+
+    try {
+        if (use_raw)
+            replies = _exec_raw_pipeline(_get_raw_address(&db), cmds, sink);
+        else
+            replies.push_back(CommandReply(db.command(pipeline)));
+    }
+    catch (sw::redis::RedirectionError& e) {
+        // MOVED and ASK redirects are followed by the caller
+        throw;
+    }
+    catch (sw::redis::ReplyError& e) {
+        // redis-plus-plus throws rather than returning an error
+        // reply for the final command
+        throw SRRuntimeException("Redis failed to execute command: " +
+                                 cmds.back()->first_field() + ": " +
+                                 e.what());
+    }
+    return replies;
+}
+
+// Send a group of Command on a raw hiredis connection and collect
+// the replies
+std::vector<CommandReply>
+RedisServer::_exec_raw_pipeline(const std::string& address,
+                                std::vector<Command*>& cmds,
+                                TensorBlobSink* sink)
+{
+    std::vector<CommandReply> replies;
+    replies.reserve(cmds.size());
+    RedisReplyUPtr final_reply;
+
+    redisContext* context = _raw_connections.acquire(address);
+    try {
+        _send_raw_commands(context, cmds);
+        if (sink != NULL)
+            sink->attach(context);
+        for (size_t i = 0; i + 1 < cmds.size(); i++)
+            replies.push_back(CommandReply(_read_raw_reply(context)));
+        final_reply = _read_raw_reply(context);
+        if (sink != NULL)
+            sink->detach();
+    }
+    catch (...) {
+        // The sink must be detached before its reader is freed
+        if (sink != NULL)
+            sink->detach();
+        redisFree(context);
+        throw;
+    }
+    _raw_connections.release(address, context);
+
+    // As redis-plus-plus does, an error reply to the final
+    // Command is thrown
+    if (final_reply->type == REDIS_REPLY_ERROR)
+        sw::redis::throw_error(*final_reply);
+    replies.push_back(CommandReply(std::move(final_reply)));
+    return replies;
+}
+
+// Write a group of Command to a database node without reading
+// the replies
+redisContext* RedisServer::_send_pipeline(sw::redis::Redis& db,
+                                          std::vector<Command*>& cmds)
+{
+    redisContext* context = _raw_connections.acquire(_get_raw_address(&db));
+    try {
+        _send_raw_commands(context, cmds);
+    }
+    catch (...) {
+        redisFree(context);
+        throw;
+    }
+    return context;
+}
+
+// Read the replies to a group of Command written with _send_pipeline()
+std::vector<CommandReply>
+RedisServer::_recv_pipeline(sw::redis::Redis& db, redisContext* context,
+                            size_t n_replies)
+{
+    std::vector<CommandReply> replies;
+    replies.reserve(n_replies);
+    try {
+        for (size_t i = 0; i < n_replies; i++)
+            replies.push_back(CommandReply(_read_raw_reply(context)));
+    }
+    catch (...) {
+        redisFree(context);
+        throw;
+    }
+    _raw_connections.release(_get_raw_address(&db), context);
+    return replies;
+}
+
+// Write a group of Command to a raw hiredis connection
+void RedisServer::_send_raw_commands(redisContext* context,
+                                     std::vector<Command*>& cmds)
+{
+    // Command are buffered by hiredis.  _send_vectored() flushes the
+    // buffer before writing, so the order of the Command is preserved.
+    std::vector<Command*>::iterator cmd = cmds.begin();
+    for ( ; cmd != cmds.end(); cmd++) {
+        if (_use_vectored_send(**cmd)) {
+            _send_vectored(context, **cmd);
+            continue;
+        }
+        std::vector<const char*> argv;
+        std::vector<size_t> argv_len;
+        Command::const_iterator field = (*cmd)->cbegin();
+        for ( ; field != (*cmd)->cend(); field++) {
+            argv.push_back(field->data());
+            argv_len.push_back(field->size());
+        }
+        if (redisAppendCommandArgv(context, (int)argv.size(), argv.data(),
+                                   argv_len.data()) != REDIS_OK) {
+            sw::redis::throw_error(*context, "Failed to send command");
+        }
+    }
+
+    // Flush the buffer so that the database node can start on the
+    // Command before any reply is read
+    int done = 0;
+    while (done == 0) {
+        if (redisBufferWrite(context, &done) != REDIS_OK)
+            sw::redis::throw_error(*context, "Failed to flush command buffer");
+    }
+}
+
+// Read a single reply from a raw hiredis connection
+RedisReplyUPtr RedisServer::_read_raw_reply(redisContext* context)
+{
+    void* reply = NULL;
+    if (redisGetReply(context, &reply) != REDIS_OK)
+        sw::redis::throw_error(*context, "Failed to read reply");
+    return RedisReplyUPtr((redisReply*)reply, sw::redis::ReplyDeleter());
+}
+
+// Execute a single Command on a database node
+CommandReply RedisServer::_exec_command(sw::redis::Redis& db,
+                                        const Command& cmd)
+{
+    if (!_use_vectored_send(cmd))
+        return CommandReply(db.command(cmd.cbegin(), cmd.cend()));
+
+    std::vector<Command*> cmds = {const_cast<Command*>(&cmd)};
+    std::vector<CommandReply> replies =
+        _exec_raw_pipeline(_get_raw_address(&db), cmds, NULL);
+    return std::move(replies[0]);
+}
+
+// Record the address on which raw connections to a database node
+// are opened
+void RedisServer::_set_raw_address(const sw::redis::Redis* db,
+                                   const std::string& address)
+{
+    std::lock_guard<std::mutex> lock(_raw_addresses_mutex);
+    _raw_addresses[db] = address;
+}
+
+// Get the address on which raw connections to a database node
+// are opened
+std::string RedisServer::_get_raw_address(const sw::redis::Redis* db)
+{
+    std::lock_guard<std::mutex> lock(_raw_addresses_mutex);
+    auto it = _raw_addresses.find(db);
+    if (it == _raw_addresses.end())
+        throw SRInternalException("No address is known for a database "\
+                                  "node connection");
+    return it->second;
+}
+
+// Check whether a Command has a field large enough for a vectored send
+bool RedisServer::_use_vectored_send(const Command& cmd)
+{
+    Command::const_iterator field = cmd.cbegin();
+    for ( ; field != cmd.cend(); field++) {
+        if (field->size() >= _VECTORED_SEND_THRESHOLD)
+            return true;
+    }
+    return false;
+}
+
+// Write a Command to a connection with vectored I/O
+void RedisServer::_send_vectored(redisContext* context, const Command& cmd)
+{
+    // Flush anything that hiredis has already buffered, such as
+    // earlier Command of the same pipeline
+    int done = 0;
+    while (done == 0) {
+        if (redisBufferWrite(context, &done) != REDIS_OK)
+            sw::redis::throw_error(*context, "Failed to flush command buffer");
+    }
+
+    /* The RESP headers and small fields are formatted into
+    resp_buf.  Each large field is recorded with the offset
+    into resp_buf at which it is to be written, and the iovec
+    list is only built once resp_buf will no longer grow.
+    */
+    std::string resp_buf;
+    std::vector<std::pair<size_t, std::string_view> > large_fields;
+    size_t n_fields = cmd.cend() - cmd.cbegin();
+    resp_buf += "*" + std::to_string(n_fields) + "\r\n";
+    Command::const_iterator field = cmd.cbegin();
+    for ( ; field != cmd.cend(); field++) {
+        resp_buf += "$" + std::to_string(field->size()) + "\r\n";
+        if (field->size() >= _VECTORED_SEND_THRESHOLD)
+            large_fields.push_back({resp_buf.size(), *field});
+        else
+            resp_buf.append(field->data(), field->size());
+        resp_buf += "\r\n";
+    }
+
+    std::vector<struct iovec> iov;
+    iov.reserve(2 * large_fields.size() + 1);
+    size_t offset = 0;
+    for (size_t i = 0; i < large_fields.size(); i++) {
+        size_t next = large_fields[i].first;
+        iov.push_back({(void*)(resp_buf.data() + offset), next - offset});
+        iov.push_back({(void*)large_fields[i].second.data(),
+                       large_fields[i].second.size()});
+        offset = next;
+    }
+    iov.push_back({(void*)(resp_buf.data() + offset),
+                   resp_buf.size() - offset});
+
+    // Write the segments, resuming after short writes
+    size_t seg = 0;
+    while (seg < iov.size()) {
+        int n_segs = (int)std::min(iov.size() - seg, (size_t)IOV_MAX);
+        ssize_t n_written = writev(context->fd, &iov[seg], n_segs);
+        if (n_written < 0) {
+            if (errno == EINTR)
+                continue;
+            // Leave the context in an error state so that a connection
+            // holding a partial command is not reused
+            context->err = REDIS_ERR_IO;
+            strncpy(context->errstr, strerror(errno),
+                    sizeof(context->errstr) - 1);
+            context->errstr[sizeof(context->errstr) - 1] = '\0';
+            sw::redis::throw_error(*context, "Failed to write command");
+        }
+        size_t n_left = (size_t)n_written;
+        while (seg < iov.size() && n_left >= iov[seg].iov_len) {
+            n_left -= iov[seg].iov_len;
+            seg++;
+        }
+        if (seg < iov.size()) {
+            iov[seg].iov_base = (char*)iov[seg].iov_base + n_left;
+            iov[seg].iov_len -= n_left;
+        }
+    }
+}
+
+// Get a Tensor from a database node, writing its data into a sink
+CommandReply RedisServer::_get_tensor_to_sink(sw::redis::Redis& db,
+                                              const std::string& key,
+                                              TensorBlobSink& sink)
+{
+    GetTensorCommand get_cmd;
+    get_cmd.add_field("AI.TENSORGET");
+    get_cmd.add_field(key, true);
+    get_cmd.add_field("META");
+    get_cmd.add_field("BLOB");
+
+    std::vector<Command*> cmds = {&get_cmd};
+    std::vector<CommandReply> replies = _run_pipeline(db, cmds, &sink);
+    return std::move(replies[0]);
+}
@@ -0,0 +1,465 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "sharedtensorcache.h"
+#include "gettensorcommand.h"
+#include "addressatcommand.h"
+
+using namespace SmartRedis;
+
+// The header at the start of each segment.  The dimensions and the
+// identity of the tensor follow it, and the tensor data start at the
+// next page boundary.
+struct SegmentHeader
+{
+    std::atomic<uint32_t> state;
+    std::atomic<uint32_t> n_attached;
+    uint32_t type;
+    uint32_t n_dims;
+    uint64_t id_len;
+    uint64_t data_offset;
+    uint64_t data_bytes;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "Segment states must be lock free to be shared "\
+              "between processes");
+
+// States of a segment.  A new segment is zero filled, so it starts
+// out as being filled.
+static const uint32_t _SEGMENT_FILLING = 0;
+static const uint32_t _SEGMENT_READY = 1;
+static const uint32_t _SEGMENT_RETIRED = 2;
+
+// SharedTensorCache constructor
+SharedTensorCache::SharedTensorCache()
+    : _page_size((size_t)sysconf(_SC_PAGESIZE))
+{
+    // Intentionally empty
+}
+
+// SharedTensorCache destructor
+SharedTensorCache::~SharedTensorCache()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto it = _mappings.begin(); it != _mappings.end(); it++)
+        _detach(it->second);
+    for (size_t i = 0; i < _retired.size(); i++)
+        _detach(_retired[i]);
+    _mappings.clear();
+    _retired.clear();
+}
+
+// Get a read-only view of a tensor, fetching it from the database
+// if no process on the compute node has done so yet
+bool SharedTensorCache::get(RedisServer& server,
+                            const std::string& key,
+                            std::string_view& blob,
+                            std::vector<size_t>& dims,
+                            SRTensorType& type,
+                            bool hand_out)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string id = _segment_id(server, key);
+    if (id.empty())
+        return false;
+    std::string name = _segment_name(id);
+
+    // Reuse the mapping of this process unless the tensor was
+    // written since
+    auto it = _mappings.find(name);
+    if (it != _mappings.end()) {
+        SegmentHeader* header = (SegmentHeader*)it->second.addr;
+        if (header->state.load(std::memory_order_acquire) ==
+            _SEGMENT_READY) {
+            it->second.handed_out |= hand_out;
+            _read(it->second, blob, dims, type);
+            return true;
+        }
+        _release(it->second);
+        _mappings.erase(it);
+    }
+
+    // A segment that is retired while it is being attached to is
+    // replaced on the second attempt
+    for (int attempt = 0; attempt < 2; attempt++) {
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd >= 0) {
+            if (!_fill(fd, name, id, server, key))
+                return false;
+        }
+        else {
+            if (errno != EEXIST)
+                return false;
+            fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0 || !_attach(fd, name, id))
+                continue;
+        }
+        Mapping& mapping = _mappings[name];
+        mapping.handed_out = hand_out;
+        _read(mapping, blob, dims, type);
+        return true;
+    }
+    return false;
+}
+
+// Remove the segment of a tensor after it was written
+void SharedTensorCache::invalidate(RedisServer& server,
+                                   const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string id = _segment_id(server, key);
+    if (id.empty())
+        return;
+    std::string name = _segment_name(id);
+
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+        return;
+
+    // Retiring the segment tells the processes that mapped it to
+    // fetch the tensor again, and a process that is still filling
+    // it not to publish what it fetched.  A segment that was just
+    // created may not have its header page yet, so it is given one.
+    struct stat st;
+    if (fstat(fd, &st) == 0 && ((size_t)st.st_size >= _page_size ||
+                                ftruncate(fd, _page_size) == 0)) {
+        void* addr = mmap(NULL, sizeof(SegmentHeader),
+                          PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            ((SegmentHeader*)addr)->state.store(_SEGMENT_RETIRED,
+                                                std::memory_order_release);
+            munmap(addr, sizeof(SegmentHeader));
+        }
+    }
+    close(fd);
+    shm_unlink(name.c_str());
+}
+
+// Remove the segments of every tensor mapped by this process
+void SharedTensorCache::invalidate_all()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto it = _mappings.begin(); it != _mappings.end(); it++) {
+        SegmentHeader* header = (SegmentHeader*)it->second.addr;
+        uint32_t ready = _SEGMENT_READY;
+        if (header->state.compare_exchange_strong(ready, _SEGMENT_RETIRED))
+            shm_unlink(it->second.name.c_str());
+    }
+}
+
+// Create a segment exclusively and fill it with a tensor
+// fetched from the database
+bool SharedTensorCache::_fill(int fd, const std::string& name,
+                              const std::string& id,
+                              RedisServer& server, const std::string& key)
+{
+    // The header page is sized before the tensor is fetched so that
+    // invalidate() can retire the segment while it is being filled
+    if (ftruncate(fd, _page_size) != 0) {
+        _abandon(fd, name);
+        return false;
+    }
+
+    CommandReply reply;
+    std::vector<size_t> dims;
+    SRTensorType type = SRTensorTypeInvalid;
+    std::string_view blob;
+    try {
+        reply = server.get_tensor(key);
+        if (!reply.has_error()) {
+            dims = GetTensorCommand::get_dims(reply);
+            type = GetTensorCommand::get_data_type(reply);
+            blob = GetTensorCommand::get_data_blob(reply);
+        }
+    }
+    catch (std::exception& e) {
+        dims.clear();
+    }
+    if (dims.size() == 0) {
+        _abandon(fd, name);
+        return false;
+    }
+
+    // The segment is grown for the data.  The space is allocated up
+    // front so that running out of shared memory is reported here
+    // rather than on first access.
+    size_t meta_bytes = sizeof(SegmentHeader) +
+                        dims.size() * sizeof(uint64_t) + id.size();
+    size_t data_offset =
+        ((meta_bytes + _page_size - 1) / _page_size) * _page_size;
+    size_t length = data_offset + blob.size();
+    if (ftruncate(fd, length) != 0 || posix_fallocate(fd, 0, length) != 0) {
+        _abandon(fd, name);
+        return false;
+    }
+    void* addr = mmap(NULL, length, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        _abandon(fd, name);
+        return false;
+    }
+    close(fd);
+
+    SegmentHeader* header = (SegmentHeader*)addr;
+    header->n_attached.fetch_add(1);
+    header->type = (uint32_t)type;
+    header->n_dims = (uint32_t)dims.size();
+    header->id_len = id.size();
+    header->data_offset = data_offset;
+    header->data_bytes = blob.size();
+    uint64_t* segment_dims = (uint64_t*)(header + 1);
+    for (size_t i = 0; i < dims.size(); i++)
+        segment_dims[i] = dims[i];
+    std::memcpy(segment_dims + dims.size(), id.data(), id.size());
+    std::memcpy((char*)addr + data_offset, blob.data(), blob.size());
+
+    // Publish the tensor unless it was written while being fetched
+    Mapping mapping = {name, addr, length, false};
+    uint32_t filling = _SEGMENT_FILLING;
+    if (!header->state.compare_exchange_strong(filling, _SEGMENT_READY,
+                                               std::memory_order_acq_rel)) {
+        _detach(mapping);
+        return false;
+    }
+    mprotect((char*)addr + data_offset, length - data_offset, PROT_READ);
+    _mappings[name] = mapping;
+    return true;
+}
+
+// Give up on filling a created segment
+void SharedTensorCache::_abandon(int fd, const std::string& name)
+{
+    shm_unlink(name.c_str());
+    if (ftruncate(fd, _page_size) == 0) {
+        void* addr = mmap(NULL, sizeof(SegmentHeader),
+                          PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+            ((SegmentHeader*)addr)->state.store(_SEGMENT_RETIRED,
+                                                std::memory_order_release);
+            munmap(addr, sizeof(SegmentHeader));
+        }
+    }
+    close(fd);
+}
+
+// Map a segment created by another process once it has been filled
+bool SharedTensorCache::_attach(int fd, const std::string& name,
+                                const std::string& id)
+{
+    auto start = std::chrono::steady_clock::now();
+    auto timed_out = [&start]() {
+        return std::chrono::steady_clock::now() - start >
+               std::chrono::milliseconds(_FILL_TIMEOUT);
+    };
+
+    // The creator of a segment gives it a header page right away.
+    // A segment without one was left behind by a process that
+    // stopped right after creating it.
+    struct stat st;
+    while (true) {
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+        if ((size_t)st.st_size >= _page_size)
+            break;
+        if (timed_out()) {
+            shm_unlink(name.c_str());
+            close(fd);
+            return false;
+        }
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(_FILL_POLL_INTERVAL));
+    }
+
+    // Wait on the header page until the segment has been filled
+    void* addr = mmap(NULL, _page_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    Mapping mapping = {name, addr, _page_size, false};
+    SegmentHeader* header = (SegmentHeader*)addr;
+    header->n_attached.fetch_add(1);
+
+    uint32_t state = header->state.load(std::memory_order_acquire);
+    while (state == _SEGMENT_FILLING) {
+        if (timed_out()) {
+            if (header->state.compare_exchange_strong(state,
+                                                      _SEGMENT_RETIRED))
+                shm_unlink(name.c_str());
+            state = _SEGMENT_RETIRED;
+            break;
+        }
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(_FILL_POLL_INTERVAL));
+        state = header->state.load(std::memory_order_acquire);
+    }
+
+    // The segment was grown for the data before it was published,
+    // so the whole of it is mapped in place of the header page
+    if (state == _SEGMENT_READY) {
+        void* full_addr = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= _page_size) {
+            full_addr = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd, 0);
+        }
+        if (full_addr != MAP_FAILED) {
+            munmap(addr, _page_size);
+            addr = full_addr;
+            mapping.addr = addr;
+            mapping.length = st.st_size;
+            header = (SegmentHeader*)addr;
+        }
+        else {
+            state = _SEGMENT_RETIRED;
+        }
+    }
+    close(fd);
+    size_t length = mapping.length;
+
+    // The segment name is a hash, so the identity is checked as well
+    const char* segment_id =
+        (const char*)((const uint64_t*)(header + 1) + header->n_dims);
+    if (state != _SEGMENT_READY || header->id_len != id.size() ||
+        header->data_offset + header->data_bytes > length ||
+        std::memcmp(segment_id, id.data(), id.size()) != 0) {
+        _detach(mapping);
+        return false;
+    }
+
+    mprotect((char*)addr + header->data_offset,
+             length - header->data_offset, PROT_READ);
+    _mappings[name] = mapping;
+    return true;
+}
+
+// Detach from a segment and unmap it
+void SharedTensorCache::_detach(Mapping& mapping)
+{
+    SegmentHeader* header = (SegmentHeader*)mapping.addr;
+    if (header->n_attached.fetch_sub(1) == 1) {
+        uint32_t ready = _SEGMENT_READY;
+        if (header->state.compare_exchange_strong(ready, _SEGMENT_RETIRED))
+            shm_unlink(mapping.name.c_str());
+    }
+    munmap(mapping.addr, mapping.length);
+}
+
+// Release a mapping whose segment was retired
+void SharedTensorCache::_release(Mapping& mapping)
+{
+    if (mapping.handed_out)
+        _retired.push_back(mapping);
+    else
+        _detach(mapping);
+}
+
+// Read the tensor held by a mapped segment
+void SharedTensorCache::_read(const Mapping& mapping,
+                              std::string_view& blob,
+                              std::vector<size_t>& dims,
+                              SRTensorType& type)
+{
+    const SegmentHeader* header = (const SegmentHeader*)mapping.addr;
+    const uint64_t* segment_dims = (const uint64_t*)(header + 1);
+    dims.assign(segment_dims, segment_dims + header->n_dims);
+    type = (SRTensorType)header->type;
+    blob = std::string_view((const char*)mapping.addr + header->data_offset,
+                            header->data_bytes);
+}
+
+// Get the identity of a tensor
+std::string SharedTensorCache::_segment_id(RedisServer& server,
+                                           const std::string& key)
+{
+    std::string address = server.get_key_address(key);
+    auto it = _run_ids.find(address);
+    if (it != _run_ids.end())
+        return it->second + "/" + address + "/" + key;
+
+    // Ask the database node for its run ID.  Nodes reached through
+    // a Unix domain socket are addressed by path with a port of 0.
+    std::string run_id;
+    try {
+        AddressAtCommand cmd;
+        if (address.size() > 0 && address[0] == '/')
+            cmd.set_exec_address_port(address, 0);
+        else
+            cmd.set_exec_address_port(cmd.parse_host(address),
+                                      cmd.parse_port(address));
+        cmd.add_field("INFO");
+        cmd.add_field("server");
+        CommandReply reply = server.run(cmd);
+        if (!reply.has_error()) {
+            std::string info(reply.str(), reply.str_len());
+            size_t start = info.find("run_id:");
+            if (start != std::string::npos) {
+                start += 7;
+                size_t end = info.find_first_of("\r\n", start);
+                run_id = info.substr(start, end - start);
+            }
+        }
+    }
+    catch (std::exception& e) {
+        run_id.clear();
+    }
+    if (run_id.empty())
+        return run_id;
+
+    _run_ids[address] = run_id;
+    return run_id + "/" + address + "/" + key;
+}
+
+// Get the name of the segment of a tensor
+std::string SharedTensorCache::_segment_name(const std::string& id)
+{
+    // FNV-1a hash of the identity of the tensor
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < id.size(); i++) {
+        hash ^= (unsigned char)id[i];
+        hash *= 1099511628211ULL;
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "/sr.%u.%016llx",
+                  (unsigned)getuid(), (unsigned long long)hash);
+    return std::string(name);
+}
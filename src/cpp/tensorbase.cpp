@@ -45,7 +45,7 @@ TensorBase::TensorBase(const std::string& name,
     owned by the tensor.
     */
 
-    _check_inputs(data, name, dims);
+    check_inputs(data, name, dims);
     _name = name;
     _type = type;
     _dims = dims;
@@ -192,9 +192,9 @@ std::string_view TensorBase::buf()
 }
 
 // Validate inputs for a tensor
-inline void TensorBase::_check_inputs(const void* src_data,
-                                      const std::string& name,
-                                      const std::vector<size_t>& dims)
+void TensorBase::check_inputs(const void* src_data,
+                              const std::string& name,
+                              const std::vector<size_t>& dims)
 {
     /* This function checks the validity of constructor
     inputs. This was taken out of the constructor to
@@ -0,0 +1,201 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "tensorblobsink.h"
+#include "tensor.h"
+#include "srexception.h"
+
+using namespace SmartRedis;
+
+// Positions of the fields in an AI.TENSORGET META BLOB reply
+static const size_t _n_reply_fields = 6;
+static const int _type_idx = 1;
+static const int _dims_idx = 3;
+static const int _blob_idx = 5;
+
+// TensorBlobSink constructor
+TensorBlobSink::TensorBlobSink(void* data,
+                               const std::vector<size_t>& dims,
+                               const SRTensorType type,
+                               const SRMemoryLayout mem_layout)
+    : _data(data), _dims(dims), _type(type), _mem_layout(mem_layout),
+      _filled(false), _reader(NULL), _default_fn(NULL),
+      _default_privdata(NULL)
+{
+    // Intentionally empty
+}
+
+// TensorBlobSink destructor
+TensorBlobSink::~TensorBlobSink()
+{
+    detach();
+}
+
+// Attach the sink to the reply reader of a hiredis context
+void TensorBlobSink::attach(redisContext* context)
+{
+    if (context == NULL || context->reader == NULL)
+        throw SRInternalException("Cannot attach a tensor sink to "\
+                                  "a connection without a reader");
+    detach();
+
+    _reader = context->reader;
+    _default_fn = _reader->fn;
+    _default_privdata = _reader->privdata;
+    _fn = *_default_fn;
+    _fn.createString = &TensorBlobSink::_create_string;
+    _reader->fn = &_fn;
+    _reader->privdata = this;
+    _filled = false;
+}
+
+// Restore the reply reader of the attached hiredis context
+void TensorBlobSink::detach()
+{
+    if (_reader == NULL)
+        return;
+    _reader->fn = _default_fn;
+    _reader->privdata = _default_privdata;
+    _reader = NULL;
+}
+
+// Check whether the memory space has been filled
+bool TensorBlobSink::filled() const
+{
+    return _filled;
+}
+
+// Create a reply string, writing the BLOB of an AI.TENSORGET
+// reply straight into the memory space when possible.  This is
+// called from hiredis, so no exception may escape it.
+void* TensorBlobSink::_create_string(const redisReadTask* task,
+                                     char* str,
+                                     size_t len)
+{
+    TensorBlobSink* sink = reinterpret_cast<TensorBlobSink*>(task->privdata);
+
+    // Only the BLOB field at the top level of the reply is diverted
+    const redisReadTask* parent = task->parent;
+    if (!sink->_filled && parent != NULL && parent->parent == NULL &&
+        parent->obj != NULL && task->idx == _blob_idx &&
+        sink->_fill((const redisReply*)parent->obj, str, len)) {
+        sink->_filled = true;
+        char empty[] = "";
+        return sink->_default_fn->createString(task, empty, 0);
+    }
+    return sink->_default_fn->createString(task, str, len);
+}
+
+// Fill the memory space with the BLOB if the tensor metadata match it
+bool TensorBlobSink::_fill(const redisReply* meta,
+                           const char* blob,
+                           size_t len)
+{
+    // The type and shape fields have already been parsed
+    if (meta->type != REDIS_REPLY_ARRAY || meta->elements != _n_reply_fields)
+        return false;
+    const redisReply* type_reply = meta->element[_type_idx];
+    const redisReply* dims_reply = meta->element[_dims_idx];
+    if (type_reply == NULL || type_reply->type != REDIS_REPLY_STRING ||
+        dims_reply == NULL || dims_reply->type != REDIS_REPLY_ARRAY)
+        return false;
+
+    try {
+        // Make sure we're unpacking the right type of data
+        std::string type_str(type_reply->str, type_reply->len);
+        auto type = TENSOR_TYPE_MAP.find(type_str);
+        if (type == TENSOR_TYPE_MAP.end() || type->second != _type)
+            return false;
+
+        // Make sure the BLOB holds exactly the described tensor
+        std::vector<size_t> reply_dims(dims_reply->elements);
+        size_t n_values = 1;
+        for (size_t i = 0; i < dims_reply->elements; i++) {
+            const redisReply* dim = dims_reply->element[i];
+            if (dim == NULL || dim->type != REDIS_REPLY_INTEGER ||
+                dim->integer <= 0)
+                return false;
+            reply_dims[i] = (size_t)dim->integer;
+            n_values *= reply_dims[i];
+        }
+        if (reply_dims.size() == 0 ||
+            n_values * TENSOR_TYPE_SIZE_MAP.at(_type) != len)
+            return false;
+
+        // Make sure we have the right dims to unpack into
+        if (_mem_layout == SRMemLayoutContiguous &&
+            (_dims.size() == 0 || _dims[0] != n_values))
+            return false;
+        if ((_mem_layout == SRMemLayoutNested ||
+             _mem_layout == SRMemLayoutFortranNested) &&
+            _dims != reply_dims)
+            return false;
+
+        switch (_type) {
+            case SRTensorTypeDouble:
+                Tensor<double>::fill_mem_space(blob, reply_dims, _data,
+                                               _dims, _mem_layout);
+                break;
+            case SRTensorTypeFloat:
+                Tensor<float>::fill_mem_space(blob, reply_dims, _data,
+                                              _dims, _mem_layout);
+                break;
+            case SRTensorTypeInt64:
+                Tensor<int64_t>::fill_mem_space(blob, reply_dims, _data,
+                                                _dims, _mem_layout);
+                break;
+            case SRTensorTypeInt32:
+                Tensor<int32_t>::fill_mem_space(blob, reply_dims, _data,
+                                                _dims, _mem_layout);
+                break;
+            case SRTensorTypeInt16:
+                Tensor<int16_t>::fill_mem_space(blob, reply_dims, _data,
+                                                _dims, _mem_layout);
+                break;
+            case SRTensorTypeInt8:
+                Tensor<int8_t>::fill_mem_space(blob, reply_dims, _data,
+                                               _dims, _mem_layout);
+                break;
+            case SRTensorTypeUint16:
+                Tensor<uint16_t>::fill_mem_space(blob, reply_dims, _data,
+                                                 _dims, _mem_layout);
+                break;
+            case SRTensorTypeUint8:
+                Tensor<uint8_t>::fill_mem_space(blob, reply_dims, _data,
+                                                _dims, _mem_layout);
+                break;
+            default:
+                return false;
+        }
+    }
+    catch (...) {
+        // Leave the reply intact so the caller can report the problem
+        return false;
+    }
+    return true;
+}
@@ -40,7 +40,9 @@ PYBIND11_MODULE(smartredisPy, m) {
     py::class_<PyClient>(m, "PyClient")
         .def(py::init<bool>())
         .def("put_tensor", &PyClient::put_tensor)
+        .def("put_tensors", &PyClient::put_tensors)
         .def("get_tensor", &PyClient::get_tensor)
+        .def("get_tensors", &PyClient::get_tensors)
         .def("delete_tensor", &PyClient::delete_tensor)
         .def("copy_tensor", &PyClient::copy_tensor)
         .def("rename_tensor", &PyClient::rename_tensor)
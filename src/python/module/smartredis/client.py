@@ -84,6 +84,33 @@ class Client(PyClient):
         dtype = Dtypes.tensor_from_numpy(data)
         super().put_tensor(name, dtype, data)
 
+    @exception_handler
+    def put_tensors(self, names, data):
+        """Put multiple tensors to a Redis database
+
+        All of the tensors are sent with pipelined commands, one
+        pipeline per database node, rather than one round trip
+        per tensor. The final tensor keys under which the tensors
+        are stored may be formed by applying a prefix to the supplied
+        names. See use_tensor_ensemble_prefix() for more details.
+
+        :param names: names for the tensors to be stored at
+        :type names: list[str]
+        :param data: numpy arrays of tensor data, one per name
+        :type data: list[np.array]
+        :raises RedisReplyError: if put fails
+        """
+        typecheck(names, "names", list)
+        typecheck(data, "data", list)
+        if len(names) != len(data):
+            raise ValueError("names and data must have the same length")
+        for name in names:
+            typecheck(name, "name", str)
+        for tensor in data:
+            typecheck(tensor, "data", np.ndarray)
+        dtypes = [Dtypes.tensor_from_numpy(tensor) for tensor in data]
+        super().put_tensors(names, dtypes, data)
+
     @exception_handler
     def get_tensor(self, name):
         """Get a tensor from the database
@@ -102,6 +129,28 @@ class Client(PyClient):
         typecheck(name, "name", str)
         return super().get_tensor(name)
 
+    @exception_handler
+    def get_tensors(self, names):
+        """Get multiple tensors from the database
+
+        All of the tensors are fetched with pipelined commands, one
+        pipeline per database node, rather than one round trip per
+        tensor. The tensor keys used to locate the tensors
+        may be formed by applying a prefix to the supplied
+        names. See set_data_source()
+        and use_tensor_ensemble_prefix() for more details.
+
+        :param names: names to get tensors from
+        :type names: list[str]
+        :raises RedisReplyError: if get fails
+        :return: numpy arrays of tensor data, one per name
+        :rtype: list[np.array]
+        """
+        typecheck(names, "names", list)
+        for name in names:
+            typecheck(name, "name", str)
+        return super().get_tensors(names)
+
     @exception_handler
     def delete_tensor(self, name):
         """Delete a tensor from the database
@@ -98,6 +98,45 @@ void PyClient::put_tensor(std::string& key,
     }
 }
 
+void PyClient::put_tensors(std::vector<std::string>& keys,
+                           std::vector<std::string>& types,
+                           std::vector<py::array>& data)
+{
+    // The buffers must outlive the call, so request them all up front
+    std::vector<py::buffer_info> buffers;
+    std::vector<void*> ptrs;
+    std::vector<std::vector<size_t>> dims;
+    std::vector<SRTensorType> ttypes;
+    for (size_t i = 0; i < data.size(); i++) {
+        buffers.push_back(data[i].request());
+        py::buffer_info& buffer = buffers.back();
+        ptrs.push_back(buffer.ptr);
+        dims.push_back(std::vector<size_t>(buffer.shape.begin(),
+                                           buffer.shape.end()));
+    }
+    for (size_t i = 0; i < types.size(); i++) {
+        ttypes.push_back(TENSOR_TYPE_MAP.at(types[i]));
+    }
+    std::vector<SRMemoryLayout> layouts(keys.size(), SRMemLayoutContiguous);
+
+    try {
+        _client->put_tensors(keys, ptrs, dims, ttypes, layouts);
+    }
+    catch (Exception& e) {
+        // exception is already prepared for caller
+        throw;
+    }
+    catch (std::exception& e) {
+        // should never happen
+        throw SRInternalException(e.what());
+    }
+    catch (...) {
+        // should never happen
+        throw SRInternalException("A non-standard exception was encountered "\
+                                  "while executing put_tensors.");
+    }
+}
+
 py::array PyClient::get_tensor(const std::string& key)
 {
     TensorBase* tensor = NULL;
@@ -118,57 +157,35 @@ py::array PyClient::get_tensor(const std::string& key)
                                   "while executing get_tensor.");
     }
 
-    // Define py::capsule lambda function for destructor
-    py::capsule free_when_done((void*)tensor, [](void *tensor) {
-            delete reinterpret_cast<TensorBase*>(tensor);
-            });
+    return _tensor_to_array(tensor);
+}
 
-    // detect data type
-    switch (tensor->type()) {
-        case SRTensorTypeDouble: {
-            double* data = reinterpret_cast<double*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        case SRTensorTypeFloat: {
-            float* data = reinterpret_cast<float*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        case SRTensorTypeInt64: {
-            int64_t* data = reinterpret_cast<int64_t*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        case SRTensorTypeInt32: {
-            int32_t* data = reinterpret_cast<int32_t*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        case SRTensorTypeInt16: {
-            int16_t* data = reinterpret_cast<int16_t*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        case SRTensorTypeInt8: {
-            int8_t* data = reinterpret_cast<int8_t*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        case SRTensorTypeUint16: {
-            uint16_t* data = reinterpret_cast<uint16_t*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        case SRTensorTypeUint8: {
-            uint8_t* data = reinterpret_cast<uint8_t*>(tensor->data_view(
-                SRMemLayoutContiguous));
-            return py::array(tensor->dims(), data, free_when_done);
-        }
-        default :
-            throw SRRuntimeException("Could not infer type in "\
-                                      "PyClient::get_tensor().");
+py::list PyClient::get_tensors(std::vector<std::string>& keys)
+{
+    std::vector<std::unique_ptr<TensorBase>> tensors;
+    try {
+        tensors = _client->get_tensor_objects(keys);
+    }
+    catch (Exception& e) {
+        // exception is already prepared for caller
+        throw;
+    }
+    catch (std::exception& e) {
+        // should never happen
+        throw SRInternalException(e.what());
     }
+    catch (...) {
+        // should never happen
+        throw SRInternalException("A non-standard exception was encountered "\
+                                  "while executing get_tensors.");
+    }
+
+    // Each tensor is released only as its array takes ownership of it,
+    // so the rest are still freed if building an array fails
+    py::list arrays;
+    for (size_t i = 0; i < tensors.size(); i++)
+        arrays.append(_tensor_to_array(tensors[i].release()));
+    return arrays;
 }
 
 void PyClient::delete_tensor(const std::string& key) {
@@ -869,4 +886,59 @@ void PyClient::save(std::vector<std::string> addresses)
     }
 }
 
+py::array PyClient::_tensor_to_array(TensorBase* tensor)
+{
+    // Define py::capsule lambda function for destructor
+    py::capsule free_when_done((void*)tensor, [](void *tensor) {
+            delete reinterpret_cast<TensorBase*>(tensor);
+            });
+
+    // detect data type
+    switch (tensor->type()) {
+        case SRTensorTypeDouble: {
+            double* data = reinterpret_cast<double*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeFloat: {
+            float* data = reinterpret_cast<float*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt64: {
+            int64_t* data = reinterpret_cast<int64_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt32: {
+            int32_t* data = reinterpret_cast<int32_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt16: {
+            int16_t* data = reinterpret_cast<int16_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeInt8: {
+            int8_t* data = reinterpret_cast<int8_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeUint16: {
+            uint16_t* data = reinterpret_cast<uint16_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        case SRTensorTypeUint8: {
+            uint8_t* data = reinterpret_cast<uint8_t*>(tensor->data_view(
+                SRMemLayoutContiguous));
+            return py::array(tensor->dims(), data, free_when_done);
+        }
+        default :
+            throw SRRuntimeException("Could not infer type in "\
+                                      "PyClient::_tensor_to_array().");
+    }
+}
+
 // EOF
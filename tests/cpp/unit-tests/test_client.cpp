@@ -373,6 +373,28 @@ SCENARIO("Testing Tensor Functions on Client Object", "[Client]")
                 }
             }
 
+            AND_THEN("The Tensors can be copied within their hash slot")
+            {
+                // copy each tensor to a key that shares its hash slot
+                for(int i=0; i<num_of_tensors; i++)
+                    client.copy_tensor(keys[i], "{" + keys[i] + "}.copied");
+
+                // ensure the copied tensors contain
+                // the correct data, dims, type
+                SRTensorType copied_type;
+                std::vector<void*> copied_datas(num_of_tensors);
+                std::vector<std::vector<size_t>> copied_dims(num_of_tensors);
+
+                for(int i=0; i<num_of_tensors; i++) {
+                    client.get_tensor("{" + keys[i] + "}.copied",
+                                      copied_datas[i], copied_dims[i],
+                                      copied_type, mem_layout);
+                    CHECK(copied_dims[i] == dims[i]);
+                    CHECK(copied_type == types[i]);
+                }
+                check_all_data(tensors_size, datas, copied_datas);
+            }
+
             AND_THEN("The Tensors can be copied")
             {
                 // copy each tensor
@@ -466,6 +488,429 @@ SCENARIO("Testing Tensor Functions on Client Object", "[Client]")
     }
 }
 
+SCENARIO("Testing batched tensor put on Client Object", "[Client]")
+{
+
+    GIVEN("A Client object and tensors spread over many keys")
+    {
+        Client client(use_cluster());
+        SRMemoryLayout mem_layout = SRMemLayoutContiguous;
+        const size_t num_of_tensors = 64;
+        std::vector<std::string> keys;
+        std::vector<std::vector<double>> tensors;
+        std::vector<void*> datas;
+        std::vector<std::vector<size_t>> dims(num_of_tensors, {2, 3});
+        std::vector<SRTensorType> types(num_of_tensors, SRTensorTypeDouble);
+        std::vector<SRMemoryLayout> layouts(num_of_tensors, mem_layout);
+        for (size_t i = 0; i < num_of_tensors; i++) {
+            keys.push_back("batch_key_" + std::to_string(i));
+            tensors.push_back(std::vector<double>(6, (double)i));
+        }
+        for (size_t i = 0; i < num_of_tensors; i++)
+            datas.push_back(tensors[i].data());
+
+        WHEN("The tensors are put into the database in one batch")
+        {
+            client.put_tensors(keys, datas, dims, types, layouts);
+
+            THEN("Each Tensor can be unpacked")
+            {
+                std::vector<double> retrieved(6);
+                for (size_t i = 0; i < num_of_tensors; i++) {
+                    client.unpack_tensor(keys[i], retrieved.data(), {6},
+                                         SRTensorTypeDouble,
+                                         SRMemLayoutContiguous);
+                    CHECK(retrieved == tensors[i]);
+                }
+            }
+
+            AND_THEN("The Tensors can be unpacked in one batch")
+            {
+                std::vector<std::vector<double>> retrieved(
+                    num_of_tensors, std::vector<double>(6));
+                std::vector<void*> retrieved_datas;
+                for (size_t i = 0; i < num_of_tensors; i++)
+                    retrieved_datas.push_back(retrieved[i].data());
+                std::vector<std::vector<size_t>> flat_dims(num_of_tensors,
+                                                           {6});
+                client.unpack_tensors(keys, retrieved_datas, flat_dims,
+                                      types, layouts);
+                CHECK(retrieved == tensors);
+            }
+
+            AND_THEN("The Tensors can be retrieved in one batch")
+            {
+                std::vector<void*> retrieved_datas;
+                std::vector<std::vector<size_t>> retrieved_dims;
+                std::vector<SRTensorType> retrieved_types;
+                client.get_tensors(keys, retrieved_datas, retrieved_dims,
+                                   retrieved_types, mem_layout);
+                REQUIRE(retrieved_datas.size() == num_of_tensors);
+                for (size_t i = 0; i < num_of_tensors; i++) {
+                    CHECK(retrieved_dims[i] == dims[i]);
+                    CHECK(retrieved_types[i] == types[i]);
+                    double* values = (double*)retrieved_datas[i];
+                    CHECK(std::vector<double>(values, values + 6) ==
+                          tensors[i]);
+                }
+            }
+
+            AND_THEN("Unpacking a batch that includes a missing key "
+                     "throws an exception")
+            {
+                std::vector<std::string> bad_keys(keys);
+                bad_keys.back() = "batch_key_DNE";
+                std::vector<std::vector<double>> retrieved(
+                    num_of_tensors, std::vector<double>(6));
+                std::vector<void*> retrieved_datas;
+                for (size_t i = 0; i < num_of_tensors; i++)
+                    retrieved_datas.push_back(retrieved[i].data());
+                std::vector<std::vector<size_t>> flat_dims(num_of_tensors,
+                                                           {6});
+                CHECK_THROWS_AS(
+                    client.unpack_tensors(bad_keys, retrieved_datas,
+                                          flat_dims, types, layouts),
+                    RuntimeException);
+            }
+        }
+
+        AND_WHEN("The batch mixes contiguous and nested memory layouts")
+        {
+            std::vector<std::vector<double*>> nested(num_of_tensors);
+            for (size_t i = 0; i < num_of_tensors; i += 2) {
+                nested[i] = {tensors[i].data(), tensors[i].data() + 3};
+                datas[i] = nested[i].data();
+                layouts[i] = SRMemLayoutNested;
+            }
+            client.put_tensors(keys, datas, dims, types, layouts);
+
+            THEN("Each Tensor can be unpacked")
+            {
+                std::vector<double> retrieved(6);
+                for (size_t i = 0; i < num_of_tensors; i++) {
+                    client.unpack_tensor(keys[i], retrieved.data(), {6},
+                                         SRTensorTypeDouble,
+                                         SRMemLayoutContiguous);
+                    CHECK(retrieved == tensors[i]);
+                }
+            }
+        }
+
+        AND_WHEN("The batch description has mismatched lengths")
+        {
+            types.pop_back();
+
+            THEN("A ParameterException is thrown")
+            {
+                CHECK_THROWS_AS(
+                    client.put_tensors(keys, datas, dims, types, layouts),
+                    ParameterException);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing asynchronous requests on Client Object", "[Client]")
+{
+
+    GIVEN("A Client object and a tensor")
+    {
+        Client client(use_cluster());
+        std::string key = "async_tensor";
+        std::vector<size_t> dims = {2, 3};
+        std::vector<double> tensor(6);
+        for (size_t i = 0; i < tensor.size(); i++)
+            tensor[i] = 1.5 * i;
+
+        WHEN("The tensor is put asynchronously and its buffer is "
+             "overwritten before the request completes")
+        {
+            std::vector<double> sent(tensor);
+            std::future<void> put = client.put_tensor_async(
+                key, sent.data(), dims, SRTensorTypeDouble,
+                SRMemLayoutContiguous);
+            std::fill(sent.begin(), sent.end(), -1.0);
+            put.get();
+
+            THEN("The tensor holds the values at the time of the call")
+            {
+                std::vector<double> retrieved(6);
+                std::future<void> unpack = client.unpack_tensor_async(
+                    key, retrieved.data(), {6}, SRTensorTypeDouble,
+                    SRMemLayoutContiguous);
+                unpack.get();
+                CHECK(retrieved == tensor);
+            }
+
+            AND_THEN("Unpacking a nonexistent tensor reports the failure "
+                     "through the future")
+            {
+                std::vector<double> retrieved(6);
+                std::future<void> unpack = client.unpack_tensor_async(
+                    "async_DNE", retrieved.data(), {6}, SRTensorTypeDouble,
+                    SRMemLayoutContiguous);
+                CHECK_THROWS_AS(unpack.get(), RuntimeException);
+            }
+        }
+
+        AND_WHEN("A DataSet is put asynchronously and destroyed before "
+                 "the request completes")
+        {
+            std::future<void> put;
+            {
+                DataSet dataset("async_dataset");
+                dataset.add_tensor("tensor", tensor.data(), dims,
+                                   SRTensorTypeDouble,
+                                   SRMemLayoutContiguous);
+                put = client.put_dataset_async(dataset);
+            }
+            put.get();
+
+            THEN("The DataSet can be retrieved asynchronously")
+            {
+                std::future<DataSet> get =
+                    client.get_dataset_async("async_dataset");
+                DataSet retrieved = get.get();
+                std::vector<double> values(6);
+                retrieved.unpack_tensor("tensor", values.data(), {6},
+                                        SRTensorTypeDouble,
+                                        SRMemLayoutContiguous);
+                CHECK(values == tensor);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing prepared tensor puts and unpacks on Client Object",
+         "[Client]")
+{
+
+    GIVEN("A Client object with a prepared put and unpack")
+    {
+        Client client(use_cluster());
+        std::string key = "prepared_tensor";
+        std::vector<size_t> dims = {2, 3};
+        PreparedPut put = client.prepare_put(key, dims, SRTensorTypeFloat);
+        PreparedUnpack unpack = client.prepare_unpack(
+            key, dims, SRTensorTypeFloat, SRMemLayoutFortranContiguous);
+
+        WHEN("The tensor is put and unpacked repeatedly with new data")
+        {
+            bool all_match = true;
+            for (size_t step = 0; step < 3; step++) {
+                std::vector<float> sent(6);
+                for (size_t i = 0; i < sent.size(); i++)
+                    sent[i] = (float)(10 * step + i);
+                client.put_tensor(put, sent.data());
+
+                std::vector<float> retrieved(6);
+                client.unpack_tensor(unpack, retrieved.data());
+                std::vector<float> expected = {sent[0], sent[3], sent[1],
+                                               sent[4], sent[2], sent[5]};
+                all_match = all_match && (retrieved == expected);
+            }
+
+            THEN("Every step retrieves the values of that step")
+            {
+                CHECK(all_match);
+                CHECK(client.tensor_exists(key));
+            }
+        }
+
+        AND_WHEN("Handles are used without being prepared")
+        {
+            PreparedPut empty_put;
+            PreparedUnpack empty_unpack;
+            std::vector<float> data(6);
+
+            THEN("An error is thrown")
+            {
+                CHECK_THROWS_AS(client.put_tensor(empty_put, data.data()),
+                                ParameterException);
+                CHECK_THROWS_AS(
+                    client.unpack_tensor(empty_unpack, data.data()),
+                    ParameterException);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing the read cache on Client Object", "[Client]")
+{
+
+    GIVEN("A Client object with the read cache enabled")
+    {
+        Client client(use_cluster());
+        client.use_read_cache(1024 * 1024);
+        std::string key = "read_cache_tensor";
+        std::vector<size_t> dims = {4};
+        std::vector<double> sent = {1.0, 2.0, 3.0, 4.0};
+        client.put_tensor(key, sent.data(), dims,
+                          SRTensorTypeDouble, SRMemLayoutContiguous);
+
+        WHEN("The tensor is read, overwritten and read again")
+        {
+            std::vector<double> first(4);
+            client.unpack_tensor(key, first.data(), dims,
+                                 SRTensorTypeDouble, SRMemLayoutContiguous);
+            std::vector<double> cached(4);
+            client.unpack_tensor(key, cached.data(), dims,
+                                 SRTensorTypeDouble, SRMemLayoutContiguous);
+
+            std::vector<double> updated = {5.0, 6.0, 7.0, 8.0};
+            client.put_tensor(key, updated.data(), dims,
+                              SRTensorTypeDouble, SRMemLayoutContiguous);
+            std::vector<double> second(4);
+            client.unpack_tensor(key, second.data(), dims,
+                                 SRTensorTypeDouble, SRMemLayoutContiguous);
+
+            THEN("Every read retrieves the latest values")
+            {
+                CHECK(first == sent);
+                CHECK(cached == sent);
+                CHECK(second == updated);
+            }
+        }
+
+        AND_WHEN("The tensor is read and then deleted")
+        {
+            std::vector<double> first(4);
+            client.unpack_tensor(key, first.data(), dims,
+                                 SRTensorTypeDouble, SRMemLayoutContiguous);
+            client.delete_tensor(key);
+
+            THEN("The deleted tensor can no longer be read")
+            {
+                CHECK_THROWS(client.unpack_tensor(key, first.data(), dims,
+                                                  SRTensorTypeDouble,
+                                                  SRMemLayoutContiguous));
+            }
+        }
+    }
+}
+
+SCENARIO("Testing the shared tensor cache on Client Object", "[Client]")
+{
+
+    GIVEN("Two Client objects using the shared tensor cache")
+    {
+        Client writer(use_cluster());
+        Client reader(use_cluster());
+        writer.use_shared_tensor_cache(true);
+        reader.use_shared_tensor_cache(true);
+        std::string key = "shared_cache_tensor";
+        std::vector<size_t> dims = {3};
+        std::vector<int32_t> sent = {1, 2, 3};
+        writer.put_tensor(key, sent.data(), dims,
+                          SRTensorTypeInt32, SRMemLayoutContiguous);
+
+        WHEN("Both clients read the tensor")
+        {
+            const void* writer_data = NULL;
+            const void* reader_data = NULL;
+            std::vector<size_t> writer_dims;
+            std::vector<size_t> reader_dims;
+            SRTensorType writer_type = SRTensorTypeInvalid;
+            SRTensorType reader_type = SRTensorTypeInvalid;
+            writer.get_shared_tensor(key, writer_data,
+                                     writer_dims, writer_type);
+            reader.get_shared_tensor(key, reader_data,
+                                     reader_dims, reader_type);
+
+            THEN("Both read the tensor that was put")
+            {
+                CHECK(writer_dims == dims);
+                CHECK(reader_dims == dims);
+                CHECK(writer_type == SRTensorTypeInt32);
+                CHECK(reader_type == SRTensorTypeInt32);
+                CHECK(std::memcmp(reader_data, sent.data(),
+                                  sent.size() * sizeof(int32_t)) == 0);
+            }
+
+            AND_WHEN("The tensor is overwritten by one of the clients")
+            {
+                std::vector<int32_t> updated = {4, 5, 6};
+                writer.put_tensor(key, updated.data(), dims,
+                                  SRTensorTypeInt32, SRMemLayoutContiguous);
+                std::vector<int32_t> unpacked(3);
+                reader.unpack_tensor(key, unpacked.data(), dims,
+                                     SRTensorTypeInt32,
+                                     SRMemLayoutContiguous);
+
+                THEN("The other client reads the new tensor")
+                {
+                    CHECK(unpacked == updated);
+                    CHECK(std::memcmp(reader_data, sent.data(),
+                                      sent.size() * sizeof(int32_t)) == 0);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Testing poll_dataset wake-up on Client Object", "[Client]")
+{
+
+    GIVEN("A Client object waiting for a DataSet that is not yet stored")
+    {
+        Client client(use_cluster());
+        std::string dataset_name = "poll_wakeup_dataset";
+        std::vector<double> tensor(6, 2.5);
+
+        WHEN("Another client puts the DataSet while the first one polls "
+             "with a long interval")
+        {
+            std::thread producer([&]() {
+                Client producer_client(use_cluster());
+                DataSet dataset(dataset_name);
+                dataset.add_tensor("tensor", tensor.data(), {2, 3},
+                                   SRTensorTypeDouble,
+                                   SRMemLayoutContiguous);
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                producer_client.put_dataset(dataset);
+            });
+            auto start = std::chrono::steady_clock::now();
+            bool found = client.poll_dataset(dataset_name, 20000, 2);
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            producer.join();
+
+            THEN("The poll returns once the DataSet is stored rather "
+                 "than at the end of the interval")
+            {
+                CHECK(found);
+                CHECK(elapsed < std::chrono::milliseconds(10000));
+            }
+
+            AND_THEN("The DataSet is no longer found once deleted")
+            {
+                client.delete_dataset(dataset_name);
+                CHECK_FALSE(client.poll_dataset(dataset_name, 50, 3));
+            }
+        }
+
+        WHEN("The DataSet holds a tensor named ready")
+        {
+            std::string ready_name = "poll_ready_tensor_dataset";
+            DataSet dataset(ready_name);
+            dataset.add_tensor("ready", tensor.data(), {2, 3},
+                               SRTensorTypeDouble, SRMemLayoutContiguous);
+
+            THEN("The tensor does not collide with the ready signal")
+            {
+                CHECK_NOTHROW(client.put_dataset(dataset));
+                CHECK(client.poll_dataset(ready_name, 50, 3));
+                DataSet retrieved = client.get_dataset(ready_name);
+                std::vector<double> unpacked(6);
+                retrieved.unpack_tensor("ready", unpacked.data(), {6},
+                                        SRTensorTypeDouble,
+                                        SRMemLayoutContiguous);
+                CHECK(unpacked == tensor);
+                client.delete_dataset(ready_name);
+            }
+        }
+    }
+}
+
 SCENARIO("Testing INFO Functions on Client Object", "[Client]")
 {
 
@@ -0,0 +1,87 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstring>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "fieldarena.h"
+
+using namespace SmartRedis;
+
+SCENARIO("Testing FieldArena", "[FieldArena]")
+{
+    GIVEN("A FieldArena")
+    {
+        FieldArena arena;
+
+        WHEN("Allocations are made that need several blocks")
+        {
+            char* small = arena.allocate(16);
+            std::memset(small, 'a', 16);
+            char* large = arena.allocate(4096);
+            std::memset(large, 'b', 4096);
+            char outside[8];
+
+            THEN("Earlier allocations are preserved and the arena "\
+                 "recognizes its own memory")
+            {
+                CHECK(small[0] == 'a');
+                CHECK(small[15] == 'a');
+                CHECK(arena.contains(small));
+                CHECK(arena.contains(large + 4095));
+                CHECK_FALSE(arena.contains(outside));
+            }
+
+            AND_THEN("Memory stays valid when the arena is moved")
+            {
+                FieldArena moved(std::move(arena));
+                CHECK(moved.contains(small));
+                CHECK_FALSE(arena.contains(small));
+                CHECK(large[100] == 'b');
+            }
+        }
+
+        AND_WHEN("Space is reserved before allocating")
+        {
+            arena.allocate(8);
+            arena.reserve(1000);
+            char* first = arena.allocate(500);
+            char* second = arena.allocate(500);
+
+            THEN("The reserved allocations are adjacent")
+            {
+                CHECK(second == first + 500);
+            }
+
+            AND_THEN("The arena can be cleared")
+            {
+                arena.clear();
+                CHECK_FALSE(arena.contains(first));
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "layouttranspose.h"
+
+using namespace SmartRedis;
+
+/*
+*   ----------------------------
+*   HELPER FUNCTIONS FOR TESTING
+*   ----------------------------
+*/
+
+// Check that LayoutTranspose matches the element-wise definition of
+// the row major and column major layouts for the given dimensions,
+// and that converting back recovers the original values
+template <class T>
+bool transpose_matches_layouts(const std::vector<size_t>& dims)
+{
+    size_t n_values = 1;
+    for (size_t i = 0; i < dims.size(); i++)
+        n_values *= dims[i];
+
+    std::vector<T> c_data(n_values);
+    std::vector<T> f_data(n_values);
+    std::vector<T> round_trip(n_values);
+    for (size_t i = 0; i < n_values; i++)
+        c_data[i] = (T)i;
+
+    LayoutTranspose<T>::c_to_f(f_data.data(), c_data.data(), dims);
+
+    std::vector<size_t> position(dims.size(), 0);
+    for (size_t i = 0; i < n_values; i++) {
+        size_t c_index = 0;
+        for (size_t k = 0; k < dims.size(); k++)
+            c_index = c_index * dims[k] + position[k];
+        size_t f_index = 0;
+        for (size_t k = dims.size(); k-- > 0; )
+            f_index = f_index * dims[k] + position[k];
+        if (f_data[f_index] != c_data[c_index])
+            return false;
+
+        // Advance to the next row major position
+        for (size_t k = dims.size(); k-- > 0; ) {
+            if (++position[k] < dims[k])
+                break;
+            position[k] = 0;
+        }
+    }
+
+    LayoutTranspose<T>::f_to_c(round_trip.data(), f_data.data(), dims);
+    return round_trip == c_data;
+}
+
+SCENARIO("Testing LayoutTranspose", "[LayoutTranspose]")
+{
+    GIVEN("Tensor dimensions of several ranks and sizes")
+    {
+        std::vector<std::vector<size_t>> all_dims = {
+            {7}, {1, 5}, {5, 1}, {3, 4}, {33, 65}, {64, 64},
+            {2, 3, 4}, {5, 6, 7, 8}, {1, 40, 1, 37}, {31, 1, 33, 2, 3}
+        };
+
+        THEN("The row major and column major conversions "\
+             "are correct for each set of dimensions")
+        {
+            for (size_t i = 0; i < all_dims.size(); i++) {
+                CHECK(transpose_matches_layouts<double>(all_dims[i]));
+                CHECK(transpose_matches_layouts<int8_t>(all_dims[i]));
+            }
+        }
+    }
+
+    GIVEN("A tensor large enough to be converted with multiple threads")
+    {
+        std::vector<size_t> dims = {3, 1000, 1401};
+        setenv("SR_TRANSPOSE_THREADS", "4", 1);
+
+        THEN("The conversions are correct")
+        {
+            CHECK(transpose_matches_layouts<float>(dims));
+        }
+        unsetenv("SR_TRANSPOSE_THREADS");
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <memory>
+#include <string>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "rawconnectionpool.h"
+#include "redis.h"
+#include "rediscluster.h"
+#include "../client_test_utils.h"
+
+using namespace SmartRedis;
+
+SCENARIO("Testing RawConnectionPool", "[RawConnectionPool]")
+{
+    GIVEN("A RawConnectionPool and the address of a database node")
+    {
+        std::unique_ptr<RedisServer> server;
+        if (use_cluster())
+            server.reset(new RedisCluster());
+        else
+            server.reset(new Redis());
+        std::string address = server->get_key_address("rawpool_key");
+        RawConnectionPool pool;
+
+        WHEN("A connection is acquired")
+        {
+            redisContext* context = pool.acquire(address);
+
+            THEN("The connection can run a command")
+            {
+                REQUIRE(context != NULL);
+                redisReply* reply = (redisReply*)redisCommand(context, "PING");
+                REQUIRE(reply != NULL);
+                CHECK(reply->type == REDIS_REPLY_STATUS);
+                CHECK(std::string(reply->str, reply->len) == "PONG");
+                freeReplyObject(reply);
+                pool.release(address, context);
+            }
+
+            AND_WHEN("It is released without an error")
+            {
+                pool.release(address, context);
+
+                THEN("It is handed out again")
+                {
+                    redisContext* again = pool.acquire(address);
+                    CHECK(again == context);
+                    pool.release(address, again);
+                }
+            }
+
+            AND_WHEN("It is released with an error")
+            {
+                redisContext* other = pool.acquire(address);
+                REQUIRE(other != context);
+                context->err = REDIS_ERR_IO;
+                pool.release(address, context);
+                pool.release(address, other);
+
+                THEN("It is closed instead of being handed out again")
+                {
+                    redisContext* again = pool.acquire(address);
+                    CHECK(again == other);
+                    pool.release(address, again);
+                }
+            }
+        }
+
+        THEN("A connection to an address without a database fails")
+        {
+            CHECK_THROWS_AS(pool.acquire("127.0.0.1:1"), sw::redis::IoError);
+            CHECK(RawConnectionPool::connect("no_port") == NULL);
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "readcache.h"
+#include "redis.h"
+#include "rediscluster.h"
+#include "singlekeycommand.h"
+#include "../client_test_utils.h"
+
+using namespace SmartRedis;
+
+/*
+*   ----------------------------
+*   HELPER FUNCTIONS FOR TESTING
+*   ----------------------------
+*/
+
+// Set a string key through the usual connection of the server
+void set_string(RedisServer& server, const std::string& key,
+                const std::string& value)
+{
+    SingleKeyCommand cmd;
+    cmd.add_field("SET");
+    cmd.add_field(key, true);
+    cmd.add_field(value);
+    CommandReply reply = server.run(cmd);
+    REQUIRE(!reply.has_error());
+}
+
+// Read a string key through the cache
+std::shared_ptr<CommandReply> cached_get(ReadCache& cache,
+                                         RedisServer& server,
+                                         const std::string& key)
+{
+    SingleKeyCommand cmd;
+    cmd.add_field("GET");
+    cmd.add_field(key, true);
+    return cache.get(server.get_key_address(key), key, cmd);
+}
+
+// Get the string held by a reply
+std::string reply_string(std::shared_ptr<CommandReply> reply)
+{
+    return std::string(reply->str(), reply->str_len());
+}
+
+SCENARIO("Testing ReadCache", "[ReadCache]")
+{
+    GIVEN("A ReadCache and a server connection")
+    {
+        std::unique_ptr<RedisServer> server;
+        if (use_cluster())
+            server.reset(new RedisCluster());
+        else
+            server.reset(new Redis());
+        std::string key = "readcache_key";
+        set_string(*server, key, "first");
+        ReadCache cache(1024 * 1024);
+
+        THEN("A budget of zero bytes is rejected")
+        {
+            CHECK_THROWS_AS(ReadCache(0), ParameterException);
+        }
+
+        WHEN("A key is read twice")
+        {
+            std::shared_ptr<CommandReply> first =
+                cached_get(cache, *server, key);
+            std::shared_ptr<CommandReply> second =
+                cached_get(cache, *server, key);
+
+            THEN("The second read is served from the cache")
+            {
+                REQUIRE(first != nullptr);
+                CHECK(first == second);
+                CHECK(reply_string(first) == "first");
+                CHECK(cache.n_entries() == 1);
+                CHECK(cache.n_bytes() > 0);
+            }
+
+            AND_WHEN("The key is changed through another connection")
+            {
+                set_string(*server, key, "second");
+
+                THEN("The change is announced and the new value is read")
+                {
+                    std::string value;
+                    for (int i = 0; i < 100 && value != "second"; i++) {
+                        std::this_thread::sleep_for(
+                            std::chrono::milliseconds(10));
+                        value = reply_string(cached_get(cache, *server, key));
+                    }
+                    CHECK(value == "second");
+                }
+            }
+
+            AND_WHEN("The key is invalidated locally")
+            {
+                cache.invalidate(key);
+
+                THEN("The key is no longer cached")
+                {
+                    CHECK(cache.n_entries() == 0);
+                    CHECK(cache.n_bytes() == 0);
+                    CHECK(cached_get(cache, *server, key) != first);
+                }
+            }
+
+            AND_WHEN("The cache is cleared")
+            {
+                cache.clear();
+
+                THEN("No key is cached")
+                {
+                    CHECK(cache.n_entries() == 0);
+                    CHECK(cache.n_bytes() == 0);
+                }
+            }
+        }
+
+        WHEN("More keys are read than the memory budget allows")
+        {
+            std::string other_key = "readcache_other_key";
+            std::string value(600, 'x');
+            set_string(*server, key, value);
+            set_string(*server, other_key, value);
+            ReadCache small_cache(1000);
+            std::shared_ptr<CommandReply> first =
+                cached_get(small_cache, *server, key);
+            (void)cached_get(small_cache, *server, other_key);
+
+            THEN("The least recently used key is evicted")
+            {
+                CHECK(small_cache.n_entries() == 1);
+                CHECK(small_cache.n_bytes() <= 1000);
+                CHECK(cached_get(small_cache, *server, key) != first);
+            }
+        }
+
+        WHEN("A key that does not exist is read")
+        {
+            THEN("No reply is returned or cached")
+            {
+                CHECK(cached_get(cache, *server, "readcache_DNE") == nullptr);
+                CHECK(cache.n_entries() == 0);
+            }
+        }
+
+        WHEN("A database node cannot be reached")
+        {
+            SingleKeyCommand cmd;
+            cmd.add_field("GET");
+            cmd.add_field(key, true);
+
+            THEN("No reply is returned")
+            {
+                CHECK(cache.get("127.0.0.1:1", key, cmd) == nullptr);
+            }
+        }
+    }
+}
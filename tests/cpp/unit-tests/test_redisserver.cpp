@@ -27,6 +27,8 @@
  */
 
 #include "limits.h"
+#include <fstream>
+#include <sstream>
 
 #include "../../../third-party/catch/single_include/catch2/catch.hpp"
 #include "../client_test_utils.h"
@@ -34,6 +36,7 @@
 #include "redisserver.h"
 #include "rediscluster.h"
 #include "redis.h"
+#include "client.h"
 #include "srexception.h"
 
 using namespace SmartRedis;
@@ -77,6 +80,9 @@ class RedisClusterTest : public RedisCluster
         int get_default_conn_interval() {return _DEFAULT_CONN_INTERVAL;}
         int get_default_cmd_timeout() {return _DEFAULT_CMD_TIMEOUT;}
         int get_default_cmd_interval() {return _DEFAULT_CMD_INTERVAL;}
+        DBNode get_slot_node(uint16_t hash_slot)
+            {return _get_slot_node(hash_slot);}
+        void refresh_topology() {_refresh_topology();}
 };
 
 // For simplicity, define constants for environment variables outside
@@ -85,6 +91,7 @@ const char* CONN_TIMEOUT_ENV_VAR = "SR_CONN_TIMEOUT";
 const char* CONN_INTERVAL_ENV_VAR = "SR_CONN_INTERVAL";
 const char* CMD_TIMEOUT_ENV_VAR = "SR_CMD_TIMEOUT";
 const char* CMD_INTERVAL_ENV_VAR = "SR_CMD_INTERVAL";
+const char* CONNS_PER_NODE_ENV_VAR = "SR_CONNS_PER_NODE";
 
 // Helper method to invoke the constructor when we expect an
 // error to be thrown
@@ -106,6 +113,7 @@ void unset_all_env_vars()
         unsetenv(CONN_INTERVAL_ENV_VAR);
         unsetenv(CMD_TIMEOUT_ENV_VAR);
         unsetenv(CMD_INTERVAL_ENV_VAR);
+        unsetenv(CONNS_PER_NODE_ENV_VAR);
 }
 
 // Helper function to check that all default values being used
@@ -302,4 +310,370 @@ SCENARIO("Test runtime settings are initialized correctly", "[RedisServer]")
             CHECK_THROWS_AS(invoke_constructor(), ParameterException);
         }
     }
-}
\ No newline at end of file
+}
+
+// Helper function to run a CommandList of SET and GET commands, which
+// spans every db node of a cluster, and check that the replies come
+// back in CommandList order
+template <class T>
+void check_pipelined_commandlist(T& server, size_t n_keys)
+{
+    CommandList cmds;
+    for (size_t i = 0; i < n_keys; i++) {
+        SingleKeyCommand* set_cmd = cmds.add_command<SingleKeyCommand>();
+        set_cmd->add_field("SET");
+        set_cmd->add_field("pipeline_key_" + std::to_string(i), true);
+        set_cmd->add_field("pipeline_value_" + std::to_string(i));
+    }
+    AddressAnyCommand* ping_cmd = cmds.add_command<AddressAnyCommand>();
+    ping_cmd->add_field("PING");
+    for (size_t i = 0; i < n_keys; i++) {
+        SingleKeyCommand* get_cmd = cmds.add_command<SingleKeyCommand>();
+        get_cmd->add_field("GET");
+        get_cmd->add_field("pipeline_key_" + std::to_string(i), true);
+    }
+
+    std::vector<CommandReply> replies = server.run(cmds);
+    REQUIRE(replies.size() == 2 * n_keys + 1);
+    CHECK(replies[n_keys].status_str() == "PONG");
+    for (size_t i = 0; i < n_keys; i++) {
+        CHECK(replies[i].status_str() == "OK");
+        std::string expected = "pipeline_value_" + std::to_string(i);
+        CommandReply& get_reply = replies[n_keys + 1 + i];
+        CHECK(std::string(get_reply.str(), get_reply.str_len()) == expected);
+    }
+}
+
+// Helper function to run a CommandList that contains a failing command
+template <class T>
+void run_failing_commandlist(T& server)
+{
+    CommandList cmds;
+    SingleKeyCommand* set_cmd = cmds.add_command<SingleKeyCommand>();
+    set_cmd->add_field("SET");
+    set_cmd->add_field("pipeline_bad_key", true);
+    set_cmd->add_field("not_a_hash");
+    SingleKeyCommand* bad_cmd = cmds.add_command<SingleKeyCommand>();
+    bad_cmd->add_field("HGET");
+    bad_cmd->add_field("pipeline_bad_key", true);
+    bad_cmd->add_field("field");
+    SingleKeyCommand* get_cmd = cmds.add_command<SingleKeyCommand>();
+    get_cmd->add_field("GET");
+    get_cmd->add_field("pipeline_bad_key", true);
+    server.run(cmds);
+}
+
+SCENARIO("Test CommandList execution is pipelined", "[RedisServer]")
+{
+    GIVEN("A Redis derived object and a CommandList of SET and GET commands")
+    {
+        unset_all_env_vars();
+        size_t n_keys = 50;
+        if (use_cluster()) {
+            RedisClusterTest redis_server;
+            THEN("The replies are returned in CommandList order")
+            {
+                check_pipelined_commandlist(redis_server, n_keys);
+            }
+            AND_THEN("A failing command in the list throws an exception")
+            {
+                CHECK_THROWS_AS(run_failing_commandlist(redis_server),
+                                RuntimeException);
+            }
+        }
+        else {
+            RedisTest redis_server;
+            THEN("The replies are returned in CommandList order")
+            {
+                check_pipelined_commandlist(redis_server, n_keys);
+            }
+            AND_THEN("A failing command in the list throws an exception")
+            {
+                CHECK_THROWS_AS(run_failing_commandlist(redis_server),
+                                RuntimeException);
+            }
+        }
+    }
+}
+
+SCENARIO("Test the cluster hash slot map", "[RedisServer]")
+{
+    GIVEN("A RedisCluster derived object")
+    {
+        if (use_cluster()) {
+            unset_all_env_vars();
+            RedisClusterTest redis_server;
+            THEN("Every hash slot is served by the db node that owns it")
+            {
+                for (uint16_t slot = 0; slot < 16384; slot++) {
+                    DBNode node = redis_server.get_slot_node(slot);
+                    CHECK(node.lower_hash_slot <= slot);
+                    CHECK(node.upper_hash_slot >= slot);
+                }
+            }
+            AND_THEN("Commands are routed while the cluster is remapped")
+            {
+                redis_server.refresh_topology();
+                check_pipelined_commandlist(redis_server, 50);
+                CHECK(redis_server.key_exists("pipeline_key_0"));
+            }
+        }
+    }
+}
+
+SCENARIO("Test the number of connections to each cluster db node",
+         "[RedisServer]")
+{
+    GIVEN("A RedisCluster derived object with several connections per node")
+    {
+        if (use_cluster()) {
+            unset_all_env_vars();
+            setenv(CONNS_PER_NODE_ENV_VAR, "4", true);
+            RedisClusterTest redis_server;
+            THEN("Commands are routed over the connections")
+            {
+                check_pipelined_commandlist(redis_server, 50);
+            }
+            unset_all_env_vars();
+        }
+    }
+    GIVEN("A RedisCluster derived object with no connections per node")
+    {
+        if (use_cluster()) {
+            unset_all_env_vars();
+            setenv(CONNS_PER_NODE_ENV_VAR, "0", true);
+            THEN("Constructor throws an exception")
+            {
+                CHECK_THROWS_AS(invoke_constructor(), ParameterException);
+            }
+            unset_all_env_vars();
+        }
+    }
+}
+
+// Helper function to get every db node of a cluster
+std::vector<DBNode> get_db_nodes(RedisClusterTest& server)
+{
+    std::vector<DBNode> nodes;
+    size_t slot = 0;
+    while (slot < 16384) {
+        nodes.push_back(server.get_slot_node((uint16_t)slot));
+        slot = nodes.back().upper_hash_slot + 1;
+    }
+    return nodes;
+}
+
+// Helper function to read the value of a string key, or an empty
+// string if the key does not exist
+std::string get_string_key(RedisClusterTest& server, const std::string& key)
+{
+    SingleKeyCommand cmd;
+    cmd.add_field("GET");
+    cmd.add_field(key, true);
+    CommandReply reply = server.run(cmd);
+    if (reply.redis_reply_type() != "REDIS_REPLY_STRING")
+        return "";
+    return std::string(reply.str(), reply.str_len());
+}
+
+SCENARIO("Test setting scripts on every cluster db node", "[RedisServer]")
+{
+    GIVEN("A RedisCluster derived object and a script")
+    {
+        if (use_cluster()) {
+            unset_all_env_vars();
+            RedisClusterTest redis_server;
+            std::vector<DBNode> nodes = get_db_nodes(redis_server);
+            std::ifstream fin("./../../mnist_data/data_processing_script.txt");
+            std::stringstream source;
+            source << fin.rdbuf();
+            std::string script = source.str();
+            std::string key = "all_nodes_script";
+
+            WHEN("The script is set")
+            {
+                redis_server.set_script(key, "CPU", script);
+
+                THEN("Every db node holds a copy and its digest")
+                {
+                    for (size_t i = 0; i < nodes.size(); i++) {
+                        std::string node_key = "{" + nodes[i].prefix +
+                                               "}." + key;
+                        CHECK(redis_server.key_exists(node_key));
+                        CHECK(get_string_key(redis_server,
+                              node_key + ".sr_digest").size() > 0);
+                    }
+                }
+
+                AND_THEN("Setting the same script again skips every "
+                         "db node")
+                {
+                    std::string digest_key = "{" + nodes[0].prefix +
+                                             "}." + key + ".sr_digest";
+                    std::string digest = get_string_key(redis_server,
+                                                        digest_key);
+                    CommandReply reply =
+                        redis_server.set_script(key, "CPU", script);
+                    CHECK(reply.redis_reply_type() == "REDIS_REPLY_STATUS");
+                    CHECK(reply.status_str() == "OK");
+                    CHECK(get_string_key(redis_server, digest_key) ==
+                          digest);
+                }
+
+                AND_THEN("A db node that lost its copy is set again")
+                {
+                    std::string node_key = "{" + nodes.back().prefix +
+                                           "}." + key;
+                    SingleKeyCommand del_cmd;
+                    del_cmd.add_field("DEL");
+                    del_cmd.add_field(node_key, true);
+                    redis_server.run(del_cmd);
+                    REQUIRE_FALSE(redis_server.key_exists(node_key));
+
+                    CommandReply reply =
+                        redis_server.set_script(key, "CPU", script);
+                    CHECK(reply.redis_reply_type() == "REDIS_REPLY_STATUS");
+                    CHECK(reply.status_str() == "OK");
+                    CHECK(redis_server.key_exists(node_key));
+                }
+
+                AND_THEN("A different script replaces every copy")
+                {
+                    std::string node_digest_key = "{" + nodes[0].prefix +
+                                                  "}." + key + ".sr_digest";
+                    std::string digest = get_string_key(redis_server,
+                                                        node_digest_key);
+                    std::string other = script + "\n# changed\n";
+                    redis_server.set_script(key, "CPU", other);
+                    CHECK(get_string_key(redis_server, node_digest_key) !=
+                          digest);
+                }
+            }
+
+            WHEN("A script that does not compile is set")
+            {
+                std::string bad_key = "all_nodes_bad_script";
+                std::string message;
+                try {
+                    redis_server.set_script(bad_key, "CPU", "def broken(:");
+                }
+                catch (RuntimeException& e) {
+                    message = e.what();
+                }
+
+                THEN("The error names every db node that failed, and "
+                     "no digest is left behind")
+                {
+                    REQUIRE(message.size() > 0);
+                    for (size_t i = 0; i < nodes.size(); i++) {
+                        std::string address = nodes[i].ip + ":" +
+                                              std::to_string(nodes[i].port);
+                        CHECK(message.find(address) != std::string::npos);
+                        CHECK(get_string_key(redis_server,
+                              "{" + nodes[i].prefix + "}." + bad_key +
+                              ".sr_digest").size() == 0);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Test running scripts and models on cluster tensors "
+         "that are local and remote to the db node", "[RedisServer]")
+{
+    GIVEN("A cluster Client with a script and a model")
+    {
+        if (use_cluster()) {
+            unset_all_env_vars();
+            RedisClusterTest redis_server;
+            Client client(true);
+            client.set_script_from_file(
+                "transfer_script", "CPU",
+                "./../../mnist_data/data_processing_script.txt");
+            client.set_model_from_file(
+                "transfer_model", "./../../mnist_data/mnist_cnn.pt",
+                "TORCH", "CPU");
+
+            // Find an input key on another db node than the output key
+            std::string remote_out = "transfer_out";
+            std::string out_node = redis_server.get_slot_node(
+                redis_server.get_hash_slot(remote_out)).name;
+            std::string remote_in;
+            for (size_t i = 0; remote_in.size() == 0; i++) {
+                std::string name = "transfer_in_" + std::to_string(i);
+                if (redis_server.get_slot_node(
+                    redis_server.get_hash_slot(name)).name != out_node)
+                    remote_in = name;
+            }
+            std::string local_in = "{transfer}.in";
+            std::string local_out = "{transfer}.out";
+
+            WHEN("A script is run on local and remote tensors")
+            {
+                std::vector<float> in = {1.0, 2.0, 3.0, 4.0};
+                client.put_tensor(local_in, in.data(), {4},
+                                  SRTensorTypeFloat, SRMemLayoutContiguous);
+                client.put_tensor(remote_in, in.data(), {4},
+                                  SRTensorTypeFloat, SRMemLayoutContiguous);
+                client.run_script("transfer_script", "pre_process",
+                                  {local_in}, {local_out});
+                client.run_script("transfer_script", "pre_process",
+                                  {remote_in}, {remote_out});
+
+                THEN("Both outputs are computed and stored "
+                     "under their own keys")
+                {
+                    std::vector<float> local_result(4);
+                    std::vector<float> remote_result(4);
+                    client.unpack_tensor(local_out, local_result.data(), {4},
+                                         SRTensorTypeFloat,
+                                         SRMemLayoutContiguous);
+                    client.unpack_tensor(remote_out, remote_result.data(),
+                                         {4}, SRTensorTypeFloat,
+                                         SRMemLayoutContiguous);
+                    for (size_t i = 0; i < in.size(); i++) {
+                        CHECK(local_result[i] == 2 * in[i]);
+                        CHECK(remote_result[i] == 2 * in[i]);
+                    }
+                }
+
+                AND_THEN("No temporary keys are left behind")
+                {
+                    std::vector<DBNode> nodes = get_db_nodes(redis_server);
+                    for (size_t i = 0; i < nodes.size(); i++) {
+                        std::string prefix = "{" + nodes[i].prefix + "}.";
+                        CHECK_FALSE(redis_server.key_exists(
+                            prefix + remote_in + ".TMP"));
+                        CHECK_FALSE(redis_server.key_exists(
+                            prefix + remote_out + ".TMP"));
+                    }
+                }
+            }
+
+            WHEN("A model is run on local and remote tensors")
+            {
+                std::vector<float> image(28 * 28, 0.5);
+                client.put_tensor(local_in, image.data(), {1, 1, 28, 28},
+                                  SRTensorTypeFloat, SRMemLayoutContiguous);
+                client.put_tensor(remote_in, image.data(), {1, 1, 28, 28},
+                                  SRTensorTypeFloat, SRMemLayoutContiguous);
+                client.run_model("transfer_model", {local_in}, {local_out});
+                client.run_model("transfer_model", {remote_in}, {remote_out});
+
+                THEN("Both runs give the same result")
+                {
+                    std::vector<float> local_result(10);
+                    std::vector<float> remote_result(10);
+                    client.unpack_tensor(local_out, local_result.data(),
+                                         {10}, SRTensorTypeFloat,
+                                         SRMemLayoutContiguous);
+                    client.unpack_tensor(remote_out, remote_result.data(),
+                                         {10}, SRTensorTypeFloat,
+                                         SRMemLayoutContiguous);
+                    CHECK(local_result == remote_result);
+                }
+            }
+        }
+    }
+}
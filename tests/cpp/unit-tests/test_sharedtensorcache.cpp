@@ -0,0 +1,224 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "sharedtensorcache.h"
+#include "client.h"
+#include "redis.h"
+#include "rediscluster.h"
+#include "../client_test_utils.h"
+
+using namespace SmartRedis;
+
+/*
+*   ----------------------------
+*   HELPER FUNCTIONS FOR TESTING
+*   ----------------------------
+*/
+
+// A server that runs a callback once after the next tensor is fetched,
+// standing in for another process that acts while the fetch is underway
+template <class Server>
+class InterleavedServer : public Server
+{
+    public:
+
+        using Server::get_tensor;
+
+        virtual CommandReply get_tensor(const std::string& key)
+        {
+            CommandReply reply = Server::get_tensor(key);
+            std::function<void()> callback;
+            callback.swap(after_get_tensor);
+            if (callback)
+                callback();
+            return reply;
+        }
+
+        std::function<void()> after_get_tensor;
+};
+
+SCENARIO("Testing SharedTensorCache", "[SharedTensorCache]")
+{
+    GIVEN("Two SharedTensorCache objects standing in for two processes")
+    {
+        Client client(use_cluster());
+        std::unique_ptr<RedisServer> server;
+        if (use_cluster())
+            server.reset(new RedisCluster());
+        else
+            server.reset(new Redis());
+
+        std::string key = "shared_tensor_cache_key";
+        std::vector<float> sent = {1.0, 2.0, 3.0, 4.0};
+        client.put_tensor(key, sent.data(), {4},
+                          SRTensorTypeFloat, SRMemLayoutContiguous);
+        SharedTensorCache first;
+        SharedTensorCache second;
+
+        WHEN("Both read the tensor")
+        {
+            std::string_view first_blob;
+            std::string_view second_blob;
+            std::vector<size_t> first_dims;
+            std::vector<size_t> second_dims;
+            SRTensorType first_type = SRTensorTypeInvalid;
+            SRTensorType second_type = SRTensorTypeInvalid;
+            bool first_read = first.get(*server, key, first_blob,
+                                        first_dims, first_type);
+            bool second_read = second.get(*server, key, second_blob,
+                                          second_dims, second_type, true);
+
+            THEN("Both map the same tensor")
+            {
+                REQUIRE(first_read);
+                REQUIRE(second_read);
+                CHECK(first_dims == std::vector<size_t>({4}));
+                CHECK(second_dims == first_dims);
+                CHECK(first_type == SRTensorTypeFloat);
+                CHECK(second_type == SRTensorTypeFloat);
+                REQUIRE(second_blob.size() == sent.size() * sizeof(float));
+                CHECK(std::memcmp(second_blob.data(), sent.data(),
+                                  second_blob.size()) == 0);
+                CHECK(std::memcmp(first_blob.data(), second_blob.data(),
+                                  first_blob.size()) == 0);
+            }
+
+            AND_WHEN("The tensor is written and invalidated")
+            {
+                std::vector<float> updated = {5.0, 6.0, 7.0, 8.0};
+                client.put_tensor(key, updated.data(), {4},
+                                  SRTensorTypeFloat, SRMemLayoutContiguous);
+                first.invalidate(*server, key);
+
+                THEN("The other reads the new tensor, and data handed "
+                     "out before remain valid")
+                {
+                    std::string_view blob;
+                    std::vector<size_t> read_dims;
+                    SRTensorType type = SRTensorTypeInvalid;
+                    REQUIRE(second.get(*server, key, blob, read_dims, type));
+                    REQUIRE(blob.size() == updated.size() * sizeof(float));
+                    CHECK(std::memcmp(blob.data(), updated.data(),
+                                      blob.size()) == 0);
+                    CHECK(std::memcmp(second_blob.data(), sent.data(),
+                                      second_blob.size()) == 0);
+                }
+
+                THEN("A process whose data were copied out reads the "
+                     "new tensor")
+                {
+                    std::string_view blob;
+                    std::vector<size_t> read_dims;
+                    SRTensorType type = SRTensorTypeInvalid;
+                    REQUIRE(first.get(*server, key, blob, read_dims, type));
+                    REQUIRE(blob.size() == updated.size() * sizeof(float));
+                    CHECK(std::memcmp(blob.data(), updated.data(),
+                                      blob.size()) == 0);
+                }
+            }
+        }
+
+        WHEN("A tensor that does not exist is read")
+        {
+            std::string_view blob;
+            std::vector<size_t> read_dims;
+            SRTensorType type = SRTensorTypeInvalid;
+
+            THEN("The tensor is not read through shared memory")
+            {
+                CHECK_FALSE(first.get(*server, "shared_tensor_cache_DNE",
+                                      blob, read_dims, type));
+                CHECK_FALSE(second.get(*server, "shared_tensor_cache_DNE",
+                                       blob, read_dims, type));
+            }
+        }
+    }
+}
+
+SCENARIO("Testing SharedTensorCache when a tensor is written while it "
+         "is being fetched", "[SharedTensorCache]")
+{
+    GIVEN("A process filling a segment and another that writes the tensor")
+    {
+        Client client(use_cluster());
+        std::unique_ptr<RedisServer> server;
+        std::function<void()>* after_get_tensor = NULL;
+        if (use_cluster()) {
+            InterleavedServer<RedisCluster>* cluster =
+                new InterleavedServer<RedisCluster>();
+            after_get_tensor = &cluster->after_get_tensor;
+            server.reset(cluster);
+        }
+        else {
+            InterleavedServer<Redis>* redis = new InterleavedServer<Redis>();
+            after_get_tensor = &redis->after_get_tensor;
+            server.reset(redis);
+        }
+
+        std::string key = "shared_tensor_cache_interleaved_key";
+        std::vector<float> sent = {1.0, 2.0, 3.0, 4.0};
+        std::vector<float> updated = {5.0, 6.0, 7.0, 8.0};
+        client.put_tensor(key, sent.data(), {4},
+                          SRTensorTypeFloat, SRMemLayoutContiguous);
+        SharedTensorCache filler;
+        SharedTensorCache writer;
+
+        WHEN("The tensor is written and invalidated after the filler "
+             "fetched it but before the filler published it")
+        {
+            *after_get_tensor = [&]() {
+                client.put_tensor(key, updated.data(), {4},
+                                  SRTensorTypeFloat, SRMemLayoutContiguous);
+                writer.invalidate(*server, key);
+            };
+            std::string_view blob;
+            std::vector<size_t> read_dims;
+            SRTensorType type = SRTensorTypeInvalid;
+            bool read = filler.get(*server, key, blob, read_dims, type);
+
+            THEN("The stale tensor is not published, and both "
+                 "processes read the new tensor afterwards")
+            {
+                CHECK_FALSE(read);
+                REQUIRE(filler.get(*server, key, blob, read_dims, type));
+                REQUIRE(blob.size() == updated.size() * sizeof(float));
+                CHECK(std::memcmp(blob.data(), updated.data(),
+                                  blob.size()) == 0);
+                REQUIRE(writer.get(*server, key, blob, read_dims, type));
+                REQUIRE(blob.size() == updated.size() * sizeof(float));
+                CHECK(std::memcmp(blob.data(), updated.data(),
+                                  blob.size()) == 0);
+            }
+        }
+    }
+}
@@ -83,5 +83,32 @@ SCENARIO("Additional Testing for various SSDBs", "[SSDB]")
 
             setenv_ssdb(old_ssdb);
         }
+
+        THEN("SSDB may name Unix domain sockets")
+        {
+            // Socket entries keep their scheme
+            setenv_ssdb("unix:///tmp/redis-0_a.sock");
+            CHECK(test_ssdb.get_ssdb() == "unix:///tmp/redis-0_a.sock");
+
+            // Socket and TCP entries can be mixed
+            setenv_ssdb("unix:///tmp/redis.sock,127.0.0.1:6379");
+            std::string hp = test_ssdb.get_ssdb();
+            CHECK((hp == "unix:///tmp/redis.sock" ||
+                   hp == "tcp://127.0.0.1:6379"));
+
+            // The socket path is empty
+            setenv_ssdb("unix://");
+            CHECK_THROWS_AS(test_ssdb.get_ssdb(), SmartRedis::RuntimeException);
+
+            // The socket path contains invalid characters
+            setenv_ssdb("unix:///tmp/redis*.sock");
+            CHECK_THROWS_AS(test_ssdb.get_ssdb(), SmartRedis::RuntimeException);
+
+            // Only socket paths may contain '/'
+            setenv_ssdb("127.0.0.1/6379");
+            CHECK_THROWS_AS(test_ssdb.get_ssdb(), SmartRedis::RuntimeException);
+
+            setenv_ssdb(old_ssdb);
+        }
     }
 }
\ No newline at end of file
@@ -132,4 +132,167 @@ SCENARIO("Testing Tensor", "[Tensor]")
             }
         }
     }
-}
\ No newline at end of file
+}
+SCENARIO("Testing Tensor fill_mem_space from external data", "[Tensor]")
+{
+
+    GIVEN("Contiguous row major data that are not held by a Tensor")
+    {
+        std::vector<size_t> dims = {2, 3};
+        std::vector<double> src = {0, 1, 2, 3, 4, 5};
+
+        WHEN("The data are unpacked into a contiguous memory space")
+        {
+            std::vector<double> dest(6);
+            Tensor<double>::fill_mem_space(src.data(), dims, dest.data(),
+                                           {6}, SRMemLayoutContiguous);
+
+            THEN("The data are copied unchanged")
+            {
+                CHECK(dest == src);
+            }
+        }
+
+        AND_WHEN("The data are unpacked into a Fortran memory space")
+        {
+            std::vector<double> dest(6);
+            Tensor<double>::fill_mem_space(src.data(), dims, dest.data(),
+                                           dims,
+                                           SRMemLayoutFortranContiguous);
+
+            THEN("The data are transposed to column major order")
+            {
+                std::vector<double> expected = {0, 3, 1, 4, 2, 5};
+                CHECK(dest == expected);
+            }
+        }
+
+        AND_WHEN("The data are unpacked into a nested memory space")
+        {
+            double row_0[3];
+            double row_1[3];
+            double* nested[2] = {row_0, row_1};
+            Tensor<double>::fill_mem_space(src.data(), dims, nested,
+                                           dims, SRMemLayoutNested);
+
+            THEN("Each row holds its values")
+            {
+                for (size_t i = 0; i < 3; i++) {
+                    CHECK(row_0[i] == src[i]);
+                    CHECK(row_1[i] == src[3 + i]);
+                }
+            }
+        }
+
+        AND_WHEN("The memory space is the wrong size")
+        {
+            std::vector<double> dest(5);
+
+            THEN("An exception is thrown")
+            {
+                CHECK_THROWS_AS(
+                    Tensor<double>::fill_mem_space(src.data(), dims,
+                                                   dest.data(), {5},
+                                                   SRMemLayoutContiguous),
+                    RuntimeException);
+            }
+        }
+    }
+}
+
+SCENARIO("Testing Tensor Fortran data view reuse", "[Tensor]")
+{
+    GIVEN("A Tensor with row major data")
+    {
+        std::vector<size_t> dims = {2, 3};
+        std::vector<double> src = {0, 1, 2, 3, 4, 5};
+        Tensor<double> t("test_tensor", src.data(), dims,
+                         SRTensorTypeDouble, SRMemLayoutContiguous);
+
+        WHEN("The Fortran data view is requested twice")
+        {
+            double* view = (double*)t.data_view(SRMemLayoutFortranContiguous);
+            double* view_2 = (double*)t.data_view(SRMemLayoutFortranContiguous);
+
+            THEN("The same column major memory space is returned")
+            {
+                std::vector<double> expected = {0, 3, 1, 4, 2, 5};
+                CHECK(view == view_2);
+                CHECK(std::vector<double>(view, view + 6) == expected);
+            }
+
+            AND_THEN("A copy of the Tensor builds its own view")
+            {
+                Tensor<double> t_copy(t);
+                double* copy_view =
+                    (double*)t_copy.data_view(SRMemLayoutFortranContiguous);
+                CHECK(copy_view != view);
+                CHECK(std::vector<double>(copy_view, copy_view + 6) ==
+                      std::vector<double>(view, view + 6));
+            }
+        }
+    }
+}
+
+SCENARIO("Testing Tensor nested memory layouts", "[Tensor]")
+{
+    GIVEN("A three dimensional Tensor with row major data")
+    {
+        std::vector<size_t> dims = {2, 3, 4};
+        std::vector<double> src(24);
+        for (size_t i = 0; i < src.size(); i++)
+            src[i] = (double)i;
+        Tensor<double> t("test_tensor", src.data(), dims,
+                         SRTensorTypeDouble, SRMemLayoutContiguous);
+
+        WHEN("Nested views are requested")
+        {
+            double*** c_view = (double***)t.data_view(SRMemLayoutNested);
+            double*** f_view =
+                (double***)t.data_view(SRMemLayoutFortranNested);
+
+            THEN("The row major view is indexed in the tensor order "\
+                 "and the column major view in the reverse order")
+            {
+                for (size_t i = 0; i < 2; i++) {
+                    for (size_t j = 0; j < 3; j++) {
+                        for (size_t k = 0; k < 4; k++) {
+                            double value = src[(i * 3 + j) * 4 + k];
+                            CHECK(c_view[i][j][k] == value);
+                            CHECK(f_view[k][j][i] == value);
+                        }
+                    }
+                }
+            }
+        }
+
+        AND_WHEN("The data are unpacked into a Fortran nested memory "\
+                 "space and used to construct a new Tensor")
+        {
+            double values[4][3][2];
+            double* rows[12];
+            double** planes[4];
+            for (size_t k = 0; k < 4; k++) {
+                planes[k] = &rows[k * 3];
+                for (size_t j = 0; j < 3; j++)
+                    rows[k * 3 + j] = values[k][j];
+            }
+            t.fill_mem_space(planes, dims, SRMemLayoutFortranNested);
+            Tensor<double> t_2("test_tensor_2", planes, dims,
+                               SRTensorTypeDouble, SRMemLayoutFortranNested);
+
+            THEN("The values are transposed into the nested space "\
+                 "and back into row major order")
+            {
+                for (size_t i = 0; i < 2; i++)
+                    for (size_t j = 0; j < 3; j++)
+                        for (size_t k = 0; k < 4; k++)
+                            CHECK(values[k][j][i] ==
+                                  src[(i * 3 + j) * 4 + k]);
+                double* data_2 =
+                    (double*)t_2.data_view(SRMemLayoutContiguous);
+                CHECK(std::vector<double>(data_2, data_2 + 24) == src);
+            }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2021-2022, Hewlett Packard Enterprise
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstring>
+#include <string>
+#include "../../../third-party/catch/single_include/catch2/catch.hpp"
+#include "tensorblobsink.h"
+
+using namespace SmartRedis;
+
+/*
+*   ----------------------------
+*   HELPER FUNCTIONS FOR TESTING
+*   ----------------------------
+*/
+
+// Build the RESP encoding of an AI.TENSORGET META BLOB reply
+// for a one-dimensional DOUBLE tensor
+std::string tensorget_reply(const double* values, size_t n_values)
+{
+    std::string blob((const char*)values, n_values * sizeof(double));
+    std::string reply = "*6\r\n"
+                        "$5\r\ndtype\r\n"
+                        "$6\r\nDOUBLE\r\n"
+                        "$5\r\nshape\r\n"
+                        "*1\r\n:" + std::to_string(n_values) + "\r\n"
+                        "$4\r\nblob\r\n";
+    reply += "$" + std::to_string(blob.size()) + "\r\n" + blob + "\r\n";
+    return reply;
+}
+
+SCENARIO("Testing TensorBlobSink", "[TensorBlobSink]")
+{
+    GIVEN("A TensorBlobSink attached to a hiredis reader")
+    {
+        double values[2] = {1.5, -2.5};
+        std::string resp = tensorget_reply(values, 2);
+
+        redisContext context;
+        std::memset(&context, 0, sizeof(context));
+        context.reader = redisReaderCreate();
+        REQUIRE(context.reader != NULL);
+
+        WHEN("A TENSORGET reply matching the memory space is read")
+        {
+            double result[2] = {0.0, 0.0};
+            TensorBlobSink sink(result, {2}, SRTensorTypeDouble,
+                                SRMemLayoutContiguous);
+            sink.attach(&context);
+            REQUIRE(redisReaderFeed(context.reader, resp.data(),
+                                    resp.size()) == REDIS_OK);
+            void* reply = NULL;
+            REQUIRE(redisReaderGetReply(context.reader, &reply) == REDIS_OK);
+            sink.detach();
+
+            THEN("The blob is written to the memory space and "\
+                 "is not copied into the reply")
+            {
+                CHECK(sink.filled());
+                CHECK(result[0] == values[0]);
+                CHECK(result[1] == values[1]);
+                redisReply* r = (redisReply*)reply;
+                REQUIRE(r->elements == 6);
+                CHECK(r->element[5]->len == 0);
+            }
+            freeReplyObject(reply);
+        }
+
+        WHEN("A TENSORGET reply of a different shape is read")
+        {
+            double result[3] = {0.0, 0.0, 0.0};
+            TensorBlobSink sink(result, {3}, SRTensorTypeDouble,
+                                SRMemLayoutContiguous);
+            sink.attach(&context);
+            REQUIRE(redisReaderFeed(context.reader, resp.data(),
+                                    resp.size()) == REDIS_OK);
+            void* reply = NULL;
+            REQUIRE(redisReaderGetReply(context.reader, &reply) == REDIS_OK);
+            sink.detach();
+
+            THEN("The memory space is untouched and the blob "\
+                 "is kept in the reply")
+            {
+                CHECK_FALSE(sink.filled());
+                CHECK(result[0] == 0.0);
+                redisReply* r = (redisReply*)reply;
+                REQUIRE(r->elements == 6);
+                CHECK(r->element[5]->len == 2 * sizeof(double));
+            }
+            freeReplyObject(reply);
+        }
+
+        redisReaderFree(context.reader);
+    }
+}
@@ -58,6 +58,34 @@ def test_3D_put_get(mock_data, use_cluster):
     send_get_arrays(client, data)
 
 
+def test_put_tensors(mock_data, use_cluster):
+    """Test put_tensors for a batch of numpy arrays"""
+
+    client = Client(None, use_cluster)
+
+    data = mock_data.create_data((10, 10))
+    keys = [f"batch_array_{str(index)}" for index in range(len(data))]
+    client.put_tensors(keys, data)
+    for key, array in zip(keys, data):
+        assert client.tensor_exists(key)
+        np.testing.assert_array_equal(client.get_tensor(key), array)
+
+
+def test_get_tensors(mock_data, use_cluster):
+    """Test get_tensors for a batch of numpy arrays"""
+
+    client = Client(None, use_cluster)
+
+    data = mock_data.create_data((10, 10))
+    keys = [f"batch_get_array_{str(index)}" for index in range(len(data))]
+    for key, array in zip(keys, data):
+        client.put_tensor(key, array)
+    returned = client.get_tensors(keys)
+    assert len(returned) == len(data)
+    for array, ret in zip(data, returned):
+        np.testing.assert_array_equal(ret, array)
+
+
 # ------- Helper Functions -----------------------------------------------
 
 